@@ -0,0 +1,716 @@
+// rubik_bench - headless benchmark suite of the two-phase solver.
+//
+// usage: rubik_bench [options]
+//   --corpus random|superflip|short|all   generated corpora to run (default all)
+//   --load FILE           solve the cube definition strings of FILE (one per line) instead
+//   --states N            states per generated corpus (default 100)
+//   --seed S              seed of the generated corpora (default 1234)
+//   --short-len L         maximal length of the short scrambles (default 8)
+//   --max-depth D         maxDepth passed to solution() (default 21)
+//   --timeout T           timeOut passed to solution() in seconds (default 1000)
+//   --cache DIR           directory of the cached pruning tables (default cache)
+//   --kernel simd|scalar  phase1 successor kernel (default simd)
+//   --tt MB               size of the phase1 transposition table, 0 disables it (default 0)
+//   --near N              radius of the near solved table, 0 disables it (default 5)
+//   --cost SPEC           move costs like "U=10 U2=18 R=14", see parseMoveCost, reports the cost of the solutions
+//   --weighted MS         solve with solutionWeighted and the --cost model, MS milliseconds per cube
+//   --solution-cache N    entries of the solution cache, 0 disables it (default 0, every state is searched)
+//   --store FILE          look solutions up in the solution store FILE and append the new ones
+//   --dedup sym|none      drop states which are symmetric to an earlier state of the corpus (default none)
+//   --json FILE           write the results as JSON to FILE, "-" for stdout
+//   --pocket N            benchmark the 2x2x2 solver (pocket.h) on N random pocket cubes instead of the corpora
+//   --threads N           threads of the --pocket batch, 0 for one per hardware thread (default 0)
+//   --partial N           benchmark the partial goal solver (partial.h) on N random cubes for the cross, an F2L pair,
+//                         EO, CO+EO and the cross with a pair instead of the corpora
+//   --nxn LIST            benchmark the NxN cube engine (bigcube.h) for the sizes in LIST like "3,7,17,33"
+//   --nxn-moves N         random moves per size of --nxn (default 1000000)
+//
+// The generated corpora come from a seeded generator, so two runs with the same arguments solve exactly the same
+// cubes:
+//   random     uniformly distributed random cubes
+//   superflip  the superflip followed by 0..3 random moves, about the hardest cubes there are
+//   short      scrambles of 1..L random moves
+// Build with -DSEARCH_NO_PREFETCH (cmake -DSOLVER_PREFETCH=OFF) to compare against the search without pruning table
+// prefetches. Node counts and phase times come from solutionStats, they are 0 in builds with -DSEARCH_NO_STATS.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "solver/search.h"
+#include "solver/coordcube.h"
+#include "solver/facecube.h"
+#include "solver/successors.h"
+#include "solver/transposition.h"
+#include "solver/nearsolved.h"
+#include "solver/randomstate.h"
+#include "solver/sequence.h"
+#include "solver/notation.h"
+#include "solver/weighted.h"
+#include "solver/solutioncache.h"
+#include "solver/symmetry.h"
+#include "solver/solutionstore.h"
+#include "solver/pocket.h"
+#include "solver/bigcube.h"
+#include "solver/partial.h"
+
+typedef struct {
+    std::string name;
+    std::vector<std::string> states;
+} corpus_t;
+
+typedef struct {
+    std::string name;
+    int states;
+    int failed;
+    double seconds;
+    long long nodes;
+    long long totalDepthCalls;
+    double phase1Seconds, phase2Seconds;
+    long long cost;             // sum of the solution costs of the --cost model
+    double p50, p90, p99, max;  // latency in ms
+    std::vector<int> lengths;   // lengths[l] = number of solutions with l moves
+} result_t;
+
+static std::string toFacelets(cubiecube_t* cc)
+{
+    char facelets[55];
+    cubieToString(cc, facelets);
+    return facelets;
+}
+
+static corpus_t randomCorpus(int count, xoshiro_t* rng)
+{
+    corpus_t corpus = { "random", {} };
+    char facelets[55];
+    for (int i = 0; i < count; i++) {
+        randomFacelets(rng, facelets);
+        corpus.states.push_back(facelets);
+    }
+    return corpus;
+}
+
+static corpus_t superflipCorpus(int count, xoshiro_t* rng)
+{
+    corpus_t corpus = { "superflip", {} };
+    cubiecube_t* superflip = get_cubiecube();
+    for (int i = 0; i < EDGE_COUNT; i++)
+        superflip->eo[i] = 1;
+    for (int i = 0; i < count; i++) {
+        cubiecube_t cc = *superflip;
+        int n = i == 0 ? 0 : (int) randomBelow(rng, 4);
+        for (int j = 0; j < n; j++)
+            appendMove(&cc, (int) randomBelow(rng, N_MOVE));
+        corpus.states.push_back(toFacelets(&cc));
+    }
+    free(superflip);
+    return corpus;
+}
+
+static corpus_t shortCorpus(int count, int maxLength, xoshiro_t* rng)
+{
+    corpus_t corpus = { "short", {} };
+    for (int i = 0; i < count; i++) {
+        cubiecube_t cc;
+        int n = 1 + (int) randomBelow(rng, maxLength);
+        compileSequence(NULL, 0, &cc);
+        for (int j = 0; j < n; j++)
+            appendMove(&cc, (int) randomBelow(rng, N_MOVE));
+        corpus.states.push_back(toFacelets(&cc));
+    }
+    return corpus;
+}
+
+static corpus_t loadCorpus(const char* path)
+{
+    corpus_t corpus = { path, {} };
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.size() == 54)
+            corpus.states.push_back(line);
+    }
+    return corpus;
+}
+
+// Drop the states whose canonical key was seen before, so no two states of the corpus are the same position
+// up to a symmetry. Malformed states are kept, they count as failures.
+static void dedupCorpus(corpus_t& corpus)
+{
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> unique;
+    for (const std::string& state : corpus.states) {
+        cubiekey_t key;
+        facecube_t* fc = get_facecube_fromstring((char*) state.c_str());
+        cubiecube_t* cc = toCubieCube(fc);
+        free(fc);
+        if (verify(cc) != 0) {
+            unique.push_back(state);
+        } else {
+            canonicalKey(cc, &key);
+            if (seen.insert(std::string((const char*) &key, sizeof(key))).second)
+                unique.push_back(state);
+        }
+        free(cc);
+    }
+    corpus.states.swap(unique);
+}
+
+// nearest rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    return sorted[(size_t) (p * (sorted.size() - 1) + 0.5)];
+}
+
+// weightedTime > 0 solves with solutionWeighted instead of solution, else a store puts solutionStored in front
+static result_t runCorpus(const corpus_t& corpus, int maxDepth, long timeOut, const char* cacheDir,
+        const movecost_t* cost, long weightedTime, solutionstore_t* store)
+{
+    result_t res = { corpus.name, (int) corpus.states.size(), 0, 0.0, 0, 0, 0.0, 0.0, 0, 0, 0, 0, 0, {} };
+    std::vector<double> latency;
+
+    res.lengths.assign(32, 0);
+    for (const std::string& state : corpus.states) {
+        auto start = std::chrono::steady_clock::now();
+        searchstats_t stats = {};
+        char* sol = weightedTime > 0
+                ? solutionWeighted((char*) state.c_str(), 1 << 24, weightedTime, 0, cacheDir, cost, NULL)
+                : store != NULL ? solutionStored(store, (char*) state.c_str(), maxDepth, timeOut, 0, cacheDir)
+                : solutionStats((char*) state.c_str(), maxDepth, timeOut, 0, cacheDir, &stats);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        latency.push_back(ms);
+        res.seconds += ms / 1000.0;
+        for (int d = 0; d < 31; d++)
+            res.nodes += stats.phase1Nodes[d];
+        res.nodes += stats.phase2Nodes;
+        res.totalDepthCalls += stats.totalDepthCalls;
+        res.phase1Seconds += stats.phase1Seconds;
+        res.phase2Seconds += stats.phase2Seconds;
+        if (sol == NULL) {
+            res.failed++;
+            continue;
+        }
+        unsigned char moves[64];
+        int length = parseMoves(sol, moves, 64);
+        free(sol);
+        if (length < 0 || length > 30) {// longer than any solver maneuver, e.g. a weighted one of a skewed --cost
+            res.failed++;
+            continue;
+        }
+        res.lengths[length]++;
+        res.cost += maneuverCost(cost, moves, length);
+    }
+    std::sort(latency.begin(), latency.end());
+    res.p50 = percentile(latency, 0.50);
+    res.p90 = percentile(latency, 0.90);
+    res.p99 = percentile(latency, 0.99);
+    res.max = latency.empty() ? 0.0 : latency.back();
+    return res;
+}
+
+static void printResult(const result_t& r)
+{
+    printf("%-10s %6d states %4d failed %9.3f s  p50 %8.3f  p90 %8.3f  p99 %8.3f  max %8.3f ms  %6.2f Mnodes/s\n",
+            r.name.c_str(), r.states, r.failed, r.seconds, r.p50, r.p90, r.p99, r.max,
+            r.seconds > 0 ? r.nodes / r.seconds / 1e6 : 0.0);
+    printf("%-10s phase1 %.3f s  phase2 %.3f s  %lld totalDepth calls\n", "", r.phase1Seconds, r.phase2Seconds,
+            r.totalDepthCalls);
+    printf("%-10s avg cost %.2f\n", "", r.states > r.failed ? (double) r.cost / (r.states - r.failed) : 0.0);
+    printf("%-10s lengths", "");
+    for (int l = 0; l < (int) r.lengths.size(); l++)
+        if (r.lengths[l])
+            printf(" %d:%d", l, r.lengths[l]);
+    printf("\n");
+}
+
+static void writeJson(FILE* out, const std::vector<result_t>& results, double initSeconds, int maxDepth,
+        long timeOut, unsigned int seed, int simd, int ttMegabytes, int nearDepth, long weightedTime)
+{
+    fprintf(out, "{\n");
+    fprintf(out, "  \"config\": {\"max_depth\": %d, \"timeout_s\": %ld, \"seed\": %u, \"kernel\": \"%s\", "
+            "\"prefetch\": %s, \"tt_mb\": %d, \"near_depth\": %d, \"weighted_ms\": %ld},\n", maxDepth, timeOut, seed,
+            simd ? "avx2" : "scalar",
+#if defined(SEARCH_NO_PREFETCH)
+            "false",
+#else
+            "true",
+#endif
+            ttMegabytes, nearDepth, weightedTime);
+    fprintf(out, "  \"init_s\": %.6f,\n", initSeconds);
+    fprintf(out, "  \"corpora\": [");
+    for (size_t i = 0; i < results.size(); i++) {
+        const result_t& r = results[i];
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"states\": %d, \"failed\": %d, \"total_s\": %.6f, \"nodes\": %lld, "
+                "\"nodes_per_s\": %.0f,\n", i ? "," : "", r.name.c_str(), r.states, r.failed, r.seconds, r.nodes,
+                r.seconds > 0 ? r.nodes / r.seconds : 0.0);
+        fprintf(out, "     \"phase1_s\": %.6f, \"phase2_s\": %.6f, \"total_depth_calls\": %lld, \"cost\": %lld,\n",
+                r.phase1Seconds, r.phase2Seconds, r.totalDepthCalls, r.cost);
+        fprintf(out, "     \"latency_ms\": {\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n",
+                r.p50, r.p90, r.p99, r.max);
+        fprintf(out, "     \"lengths\": {");
+        int first = 1;
+        for (int l = 0; l < (int) r.lengths.size(); l++)
+            if (r.lengths[l]) {
+                fprintf(out, "%s\"%d\": %d", first ? "" : ", ", l, r.lengths[l]);
+                first = 0;
+            }
+        fprintf(out, "}}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+// Random pocket cubes are the corners of random cubes, every pocket position comes with each of its 24 rotations.
+// They are solved one by one for the latency and with pocketSolveMany for the throughput, every maneuver is checked.
+static int runPocket(int count, unsigned int seed, int threads, const char* cacheDir, const char* jsonPath)
+{
+    std::vector<cubiecube_t> cubes(count);
+    std::vector<uint8_t> moves((size_t) count * POCKET_MAX_LENGTH);
+    std::vector<int> lengths(count), lengthCount(POCKET_MAX_LENGTH + 1, 0);
+    xoshiro_t rng;
+    uint8_t single[POCKET_MAX_LENGTH];
+    long total = 0;
+    int failed = 0;
+
+    seedRandom(&rng, seed);
+    for (cubiecube_t& cc : cubes)
+        randomCubieCube(&rng, &cc);
+
+    auto start = std::chrono::steady_clock::now();
+    long positions = initPocket(cacheDir, threads);
+    double initSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (cubiecube_t& cc : cubes)
+        total += pocketSolve(&cc, single);
+    double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    pocketSolveMany(cubes.data(), count, moves.data(), lengths.data(), threads, cacheDir);
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int i = 0; i < count; i++) {
+        cubiecube_t cc = cubes[i];
+        for (int k = 0; k < lengths[i]; k++)
+            appendMove(&cc, moves[(size_t) i * POCKET_MAX_LENGTH + k]);
+        if (lengths[i] < 0 || pocketDistance(&cc) != 0) {
+            failed++;
+            continue;
+        }
+        lengthCount[lengths[i]]++;
+    }
+
+    double singleNs = count > 0 ? singleSeconds / count * 1e9 : 0.0;
+    double perSecond = batchSeconds > 0 ? count / batchSeconds : 0.0;
+    printf("pocket: %ld positions  init: %.3f s\n", positions, initSeconds);
+    printf("%-10s %6d states %4d failed  %.1f ns/solve  batch %.3f s  %.0f solves/s  avg length %.3f\n", "pocket",
+            count, failed, singleNs, batchSeconds, perSecond, count > 0 ? (double) total / count : 0.0);
+    printf("%-10s lengths", "");
+    for (int l = 0; l <= POCKET_MAX_LENGTH; l++)
+        if (lengthCount[l])
+            printf(" %d:%d", l, lengthCount[l]);
+    printf("\n");
+
+    if (jsonPath != NULL) {
+        FILE* out = !strcmp(jsonPath, "-") ? stdout : fopen(jsonPath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 2;
+        }
+        fprintf(out, "{\n  \"config\": {\"pocket\": %d, \"seed\": %u, \"threads\": %d},\n", count, seed, threads);
+        fprintf(out, "  \"init_s\": %.6f, \"positions\": %ld, \"failed\": %d, \"single_ns\": %.1f, "
+                "\"batch_s\": %.6f, \"solves_per_s\": %.0f,\n", initSeconds, positions, failed, singleNs,
+                batchSeconds, perSecond);
+        fprintf(out, "  \"lengths\": {");
+        int first = 1;
+        for (int l = 0; l <= POCKET_MAX_LENGTH; l++)
+            if (lengthCount[l]) {
+                fprintf(out, "%s\"%d\": %d", first ? "" : ", ", l, lengthCount[l]);
+                first = 0;
+            }
+        fprintf(out, "}\n}\n");
+        if (out != stdout)
+            fclose(out);
+    }
+    return failed != 0;
+}
+
+// 1 if the n moves bring the cube to the partial goal
+static int reachesGoal(const partialgoal_t* goal, const cubiecube_t* cube, const uint8_t* moves, int n)
+{
+    cubiecube_t cc = *cube;
+    int i;
+    for (i = 0; i < n; i++)
+        appendMove(&cc, moves[i]);
+    for (i = 0; i < CORNER_COUNT; i++)
+        if (((goal->corners >> i & 1) && (cc.cp[i] != i || cc.co[i] != 0))
+                || (goal->cornerOrientation && cc.co[i] != 0))
+            return 0;
+    for (i = 0; i < EDGE_COUNT; i++)
+        if (((goal->edges >> i & 1) && (cc.ep[i] != i || cc.eo[i] != 0)) || (goal->edgeOrientation && cc.eo[i] != 0))
+            return 0;
+    return 1;
+}
+
+// Every goal solves the same random cubes, each maneuver is checked against the goal.
+static int runPartial(int count, unsigned int seed, const char* cacheDir, const char* jsonPath)
+{
+    static const unsigned cross = PARTIAL_PIECE(DR) | PARTIAL_PIECE(DF) | PARTIAL_PIECE(DL) | PARTIAL_PIECE(DB);
+    static const struct {
+        const char* name;
+        partialgoal_t goal;
+    } goals[] = {
+        { "cross", { 0, cross, 0, 0 } },
+        { "pair", { PARTIAL_PIECE(DFR), PARTIAL_PIECE(FR), 0, 0 } },
+        { "eo", { 0, 0, 0, 1 } },
+        { "coeo", { 0, 0, 1, 1 } },
+        { "crosspair", { PARTIAL_PIECE(DFR), cross | PARTIAL_PIECE(FR), 0, 0 } },
+    };
+    const int nGoals = (int) (sizeof(goals) / sizeof(goals[0]));
+    std::vector<cubiecube_t> cubes(count);
+    std::vector<double> initSeconds(nGoals), solveSeconds(nGoals);
+    std::vector<long> totalLength(nGoals);
+    std::vector<int> failed(nGoals), solved(nGoals);
+    xoshiro_t rng;
+    uint8_t moves[PARTIAL_MAX_DEPTH];
+    int g, n;
+
+    seedRandom(&rng, seed);
+    for (cubiecube_t& cc : cubes)
+        randomCubieCube(&rng, &cc);
+
+    for (g = 0; g < nGoals; g++) {
+        auto start = std::chrono::steady_clock::now();
+        partialsolver_t* solver = initPartialSolver(&goals[g].goal, cacheDir);
+        initSeconds[g] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (solver == NULL) {
+            fprintf(stderr, "cannot create the partial solver for %s\n", goals[g].name);
+            return 2;
+        }
+        totalLength[g] = 0;
+        failed[g] = solved[g] = 0;
+        start = std::chrono::steady_clock::now();
+        for (cubiecube_t& cc : cubes)
+            if ((n = partialSolve(solver, &cc, PARTIAL_MAX_DEPTH, moves)) >= 0) {
+                totalLength[g] += n;
+                solved[g]++;
+            }
+        solveSeconds[g] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // again outside of the timing, with the goal check, which also counts the unsolved cubes as failed
+        for (cubiecube_t& cc : cubes)
+            if ((n = partialSolve(solver, &cc, PARTIAL_MAX_DEPTH, moves)) < 0
+                    || !reachesGoal(&goals[g].goal, &cc, moves, n))
+                failed[g]++;
+        freePartialSolver(solver);
+
+        printf("%-10s %6d states %4d failed  init %.3f s  %.2f us/solve  avg length %.3f\n", goals[g].name, count,
+                failed[g], initSeconds[g], count > 0 ? solveSeconds[g] / count * 1e6 : 0.0,
+                solved[g] > 0 ? (double) totalLength[g] / solved[g] : 0.0);
+    }
+
+    if (jsonPath != NULL) {
+        FILE* out = !strcmp(jsonPath, "-") ? stdout : fopen(jsonPath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 2;
+        }
+        fprintf(out, "{\n  \"config\": {\"partial\": %d, \"seed\": %u},\n  \"goals\": [", count, seed);
+        for (g = 0; g < nGoals; g++)
+            fprintf(out, "%s\n    {\"name\": \"%s\", \"failed\": %d, \"init_s\": %.6f, \"solve_us\": %.3f, "
+                    "\"avg_length\": %.3f}", g ? "," : "", goals[g].name, failed[g], initSeconds[g],
+                    count > 0 ? solveSeconds[g] / count * 1e6 : 0.0,
+                    solved[g] > 0 ? (double) totalLength[g] / solved[g] : 0.0);
+        fprintf(out, "\n  ]\n}\n");
+        if (out != stdout)
+            fclose(out);
+    }
+    for (g = 0; g < nGoals; g++)
+        if (failed[g] != 0)
+            return 1;
+    return 0;
+}
+
+// 1 if count random outer layer turns give the same facelets on the 3x3x3 NxN cube as on the cubie level, compared
+// after every move
+static int matchesCubie(int count, xoshiro_t* rng)
+{
+    bigcube_t big;
+    cubiecube_t cc;
+    char bigFacelets[55], facelets[55];
+    initBigCube(&big, 3);
+    compileSequence(NULL, 0, &cc);
+    for (int i = 0; i < count; i++) {
+        int mv = (int) randomBelow(rng, N_MOVE);
+        bigmove_t m = { (uint8_t) (mv / 3), 0, 0, (uint8_t) (mv % 3 + 1) };
+        bigApply(&big, m);
+        appendMove(&cc, mv);
+        bigToString(&big, bigFacelets);
+        cubieToString(&cc, facelets);
+        if (strcmp(bigFacelets, facelets) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+// Random moves on NxN cubes: half of them turn an outer layer, a quarter an inner slice and a quarter the outer
+// layers of a random width. They are applied one by one with bigApply and all at once with bigApplyMoves, then the
+// inverse sequence must bring the cube back to solved. For N = 3 outer layer turns are also checked against the
+// cubie level (appendMove and cubieToString).
+static int runBigCube(const char* sizes, int count, unsigned int seed, const char* jsonPath)
+{
+    std::vector<bigmove_t> moves(count), inverse(count);
+    std::vector<int> ns;
+    xoshiro_t rng;
+    std::vector<double> singleSeconds, batchSeconds;
+    std::vector<int> passed;
+
+    for (const char* p = sizes; *p != '\0';) {
+        int n = (int) strtol(p, (char**) &p, 10);
+        if (n < BIG_MIN_N || n > BIG_MAX_N || (*p != ',' && *p != '\0')) {
+            fprintf(stderr, "malformed cube sizes %s\n", sizes);
+            return 2;
+        }
+        ns.push_back(n);
+        if (*p == ',')
+            p++;
+    }
+    for (size_t s = 0; s < ns.size(); s++) {
+        int n = ns[s];
+        bigcube_t single, batch;
+        seedRandom(&rng, seed);
+        for (int i = 0; i < count; i++) {
+            bigmove_t* m = &moves[i];
+            int kind = (int) randomBelow(&rng, 4);
+            m->face = (uint8_t) randomBelow(&rng, 6);
+            m->power = (uint8_t) (1 + randomBelow(&rng, 3));
+            m->first = m->last = 0;
+            if (kind == 2 && n > 2)
+                m->first = m->last = (uint8_t) (1 + randomBelow(&rng, n - 2));
+            else if (kind == 3)
+                m->last = (uint8_t) (1 + randomBelow(&rng, n - 1));
+            inverse[count - 1 - i] = invertBigMove(*m);
+        }
+        initBigCube(&single, n);
+        initBigCube(&batch, n);
+
+        auto start = std::chrono::steady_clock::now();
+        for (const bigmove_t& m : moves)
+            bigApply(&single, m);
+        singleSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        start = std::chrono::steady_clock::now();
+        bigApplyMoves(&batch, moves.data(), count);
+        batchSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        int ok = memcmp(&single, &batch, sizeof(bigcube_t)) == 0;
+        bigApplyMoves(&batch, inverse.data(), count);
+        ok = ok && bigIsSolved(&batch);
+        if (n == 3)
+            ok = ok && matchesCubie(count, &rng);
+        passed.push_back(ok);
+
+        double rate = singleSeconds[s] > 0 ? count / singleSeconds[s] : 0.0;
+        printf("%-10s %2dx%-2d %8d moves  %.1f ns/move  %.0f moves/s  batch %.0f moves/s  %s\n", "nxn", n, n, count,
+                count > 0 ? singleSeconds[s] / count * 1e9 : 0.0, rate,
+                batchSeconds[s] > 0 ? count / batchSeconds[s] : 0.0, ok ? "ok" : "FAILED");
+    }
+
+    if (jsonPath != NULL) {
+        FILE* out = !strcmp(jsonPath, "-") ? stdout : fopen(jsonPath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 2;
+        }
+        fprintf(out, "{\n  \"config\": {\"moves\": %d, \"seed\": %u},\n  \"sizes\": [", count, seed);
+        for (size_t s = 0; s < ns.size(); s++)
+            fprintf(out, "%s\n    {\"n\": %d, \"single_s\": %.6f, \"moves_per_s\": %.0f, \"batch_s\": %.6f, "
+                    "\"batch_moves_per_s\": %.0f, \"ok\": %s}", s ? "," : "", ns[s], singleSeconds[s],
+                    singleSeconds[s] > 0 ? count / singleSeconds[s] : 0.0, batchSeconds[s],
+                    batchSeconds[s] > 0 ? count / batchSeconds[s] : 0.0, passed[s] ? "true" : "false");
+        fprintf(out, "\n  ]\n}\n");
+        if (out != stdout)
+            fclose(out);
+    }
+    return std::count(passed.begin(), passed.end(), 0) != 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* corpusName = "all";
+    const char* loadPath = NULL;
+    const char* jsonPath = NULL;
+    const char* cacheDir = "cache";
+    int count = 100;
+    unsigned int seed = 1234;
+    int shortLength = 8;
+    int maxDepth = 21;
+    long timeOut = 1000;
+    int allowSimd = 1;
+    int ttMegabytes = 0;
+    int nearDepth = NEAR_SOLVED_DEPTH;
+    long weightedTime = 0;
+    long cacheEntries = 0;
+    int dedup = 0;
+    int pocketCount = 0;
+    int threads = 0;
+    int partialCount = 0;
+    const char* nxnSizes = NULL;
+    int nxnMoves = 1000000;
+    const char* storePath = NULL;
+    solutionstore_t* store = NULL;
+    movecost_t cost;
+
+    initMoveCost(&cost);
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        if (!strcmp(arg, "--corpus"))
+            corpusName = value;
+        else if (!strcmp(arg, "--load"))
+            loadPath = value;
+        else if (!strcmp(arg, "--states"))
+            count = atoi(value);
+        else if (!strcmp(arg, "--seed"))
+            seed = (unsigned int) strtoul(value, NULL, 10);
+        else if (!strcmp(arg, "--short-len"))
+            shortLength = std::max(1, atoi(value));
+        else if (!strcmp(arg, "--max-depth"))
+            maxDepth = atoi(value);
+        else if (!strcmp(arg, "--timeout"))
+            timeOut = atol(value);
+        else if (!strcmp(arg, "--cache"))
+            cacheDir = value;
+        else if (!strcmp(arg, "--kernel"))
+            allowSimd = strcmp(value, "scalar") != 0;
+        else if (!strcmp(arg, "--tt"))
+            ttMegabytes = atoi(value);
+        else if (!strcmp(arg, "--near"))
+            nearDepth = atoi(value);
+        else if (!strcmp(arg, "--cost")) {
+            if (parseMoveCost(value, &cost) != 0) {
+                fprintf(stderr, "malformed move costs %s\n", value);
+                return 2;
+            }
+        } else if (!strcmp(arg, "--weighted"))
+            weightedTime = atol(value);
+        else if (!strcmp(arg, "--solution-cache"))
+            cacheEntries = atol(value);
+        else if (!strcmp(arg, "--store"))
+            storePath = value;
+        else if (!strcmp(arg, "--dedup"))
+            dedup = !strcmp(value, "sym");
+        else if (!strcmp(arg, "--json"))
+            jsonPath = value;
+        else if (!strcmp(arg, "--pocket"))
+            pocketCount = atoi(value);
+        else if (!strcmp(arg, "--threads"))
+            threads = atoi(value);
+        else if (!strcmp(arg, "--partial"))
+            partialCount = atoi(value);
+        else if (!strcmp(arg, "--nxn"))
+            nxnSizes = value;
+        else if (!strcmp(arg, "--nxn-moves"))
+            nxnMoves = std::max(0, atoi(value));
+        else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+        i++;
+    }
+
+    if (pocketCount > 0)
+        return runPocket(pocketCount, seed, threads, cacheDir, jsonPath);
+    if (partialCount > 0)
+        return runPartial(partialCount, seed, cacheDir, jsonPath);
+    if (nxnSizes != NULL)
+        return runBigCube(nxnSizes, nxnMoves, seed, jsonPath);
+
+    int simd = selectPhase1Kernel(allowSimd);
+    initSolutionCache(cacheEntries);
+    if (storePath != NULL && (store = openSolutionStore(storePath, 1)) == NULL) {
+        fprintf(stderr, "cannot open the solution store %s\n", storePath);
+        return 2;
+    }
+    if (initTransposition((long long) ttMegabytes << 20, 6) != 0)
+        fprintf(stderr, "cannot allocate the transposition table\n");
+
+    std::vector<corpus_t> corpora;
+    if (loadPath != NULL) {
+        corpora.push_back(loadCorpus(loadPath));
+    } else {
+        xoshiro_t rng;
+        int all = !strcmp(corpusName, "all");
+        seedRandom(&rng, seed);
+        if (all || !strcmp(corpusName, "random"))
+            corpora.push_back(randomCorpus(count, &rng));
+        if (all || !strcmp(corpusName, "superflip"))
+            corpora.push_back(superflipCorpus(count, &rng));
+        if (all || !strcmp(corpusName, "short"))
+            corpora.push_back(shortCorpus(count, shortLength, &rng));
+        if (corpora.empty()) {
+            fprintf(stderr, "unknown corpus %s\n", corpusName);
+            return 2;
+        }
+    }
+    if (dedup)
+        for (corpus_t& corpus : corpora)
+            dedupCorpus(corpus);
+
+    // pruning tables (loaded from the cache or generated) and the near solved table
+    auto initStart = std::chrono::steady_clock::now();
+    if (PRUNING_INITED == 0)
+        initPruning(cacheDir);
+    initNearSolved(nearDepth, NEAR_SOLVED_EXTRA);
+    double initSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - initStart).count();
+
+    std::vector<result_t> results;
+    int failed = 0;
+    for (const corpus_t& corpus : corpora) {
+        results.push_back(runCorpus(corpus, maxDepth, timeOut, cacheDir, &cost, weightedTime, store));
+        failed += results.back().failed;
+    }
+
+#if defined(SEARCH_NO_PREFETCH)
+    printf("prefetch: off  ");
+#else
+    printf("prefetch: on  ");
+#endif
+    printf("successors: %s  transp.: %d MB  near: %d  maxDepth: %d  weighted: %ld ms  seed: %u  init: %.3f s\n",
+            simd ? "avx2" : "scalar", ttMegabytes, nearDepth, maxDepth, weightedTime, seed, initSeconds);
+    for (const result_t& r : results)
+        printResult(r);
+    if (cacheEntries > 0) {
+        cachestats_t cache;
+        solutionCacheStats(&cache);
+        printf("solution cache: %lld hits  %lld misses  %lld evictions  %ld entries\n", cache.hits, cache.misses,
+                cache.evictions, cache.entries);
+    }
+    if (store != NULL) {
+        printf("solution store: %ld solutions\n", storedSolutionCount(store));
+        closeSolutionStore(store);
+    }
+
+    if (jsonPath != NULL) {
+        FILE* out = !strcmp(jsonPath, "-") ? stdout : fopen(jsonPath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "cannot write %s\n", jsonPath);
+            return 2;
+        }
+        writeJson(out, results, initSeconds, maxDepth, timeOut, seed, simd, ttMegabytes, nearDepth, weightedTime);
+        if (out != stdout)
+            fclose(out);
+    }
+    return failed != 0;
+}
@@ -87,8 +87,8 @@ bool customAnimActive = 0;
 //cuboRubik.setLastFrameTime();
 
 // para el solver
-std::vector<std::string> movreg;
-std::vector<std::string> solvedCube;
+lastsolve_t lastSolve; // last solved state and its solution, for incremental re-solves
+std::vector<uint8_t> solvedCube;
 
 // initial colors
 colorVec backgroundColor(0.0f, 0.0f, 0.0f); // white background
@@ -205,6 +205,8 @@ const char *fragmentShaderSBSource = "#version 330 core\n"
 
 int main()
 {
+    initLastSolve(&lastSolve);
+
     // glfw: initialize and configure
     // ------------------------------
     glfwInit();
@@ -596,17 +598,15 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
     // scramble cube
     if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS){
         // empty current moves
-        movreg.clear();
-        movreg = cuboRubik.scrambleCube(30);
+        cuboRubik.scrambleCube(30);
     }
         
     // solve cube
     if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS){
-        string tempo1 = to_cube_not(movreg);
-        movreg.clear();
-        solvedCube=get_solution(tempo1);
+        // the cube is re-solved from the last solution if the user only made a few moves since
+        solvedCube=get_solution(cuboRubik.getState(), &lastSolve);
         for(int i=0;i<solvedCube.size();++i){
-            cout<<solvedCube[i]<<" ";
+            cout<<moveName(solvedCube[i])<<" ";
         }
         std::cout<<std::endl;
         //exeanimation(solvedCube,window);
@@ -623,7 +623,6 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
     // reset cube
     if (key == GLFW_KEY_K && action == GLFW_PRESS) {
         cuboRubik.resetRubik();
-        movreg.clear();
     }  
 
     // rotate cube faces
@@ -631,7 +630,6 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
     {
         //cuboRubik.rotateFace('U', -90.0f);
         cuboRubik.rotateU();
-        movreg.push_back("U");
     }
     if (key == GLFW_KEY_U && action == GLFW_PRESS)
     {
@@ -641,27 +639,22 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
     if (key == GLFW_KEY_R && action == GLFW_PRESS)
     {
         cuboRubik.rotateL(); // clockwise
-        movreg.push_back("L");
     }
     if (key == GLFW_KEY_F && action == GLFW_PRESS)
     {
         cuboRubik.rotateF(); // clockwise
-        movreg.push_back("F");
     }
     if (key == GLFW_KEY_G && action == GLFW_PRESS)
     {
         cuboRubik.rotateR(); // clockwise
-        movreg.push_back("R");
     }
     if (key == GLFW_KEY_Y && action == GLFW_PRESS)
     {
         cuboRubik.rotateB(); // clockwise
-        movreg.push_back("B");
     }
     if (key == GLFW_KEY_H && action == GLFW_PRESS)
     {
         cuboRubik.rotateD(); // clockwise
-        movreg.push_back("D");
     }
     // rotate cube slices
     if (key == GLFW_KEY_V && action == GLFW_PRESS)
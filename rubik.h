@@ -80,6 +80,7 @@ private:
     };
 
     AnimationState currentAnimation;
+    cubiecube_t faceState;  // face turns started so far compiled into one cube, slice turns are not tracked
     float lastFrameTime;
     const float EPSILON = 0.0001f;
 
@@ -224,8 +225,9 @@ private:
         bool finishedSolving;
         float scrambleStartScale;  // Scale at which to start scrambling
         float solveStartScale;     // Scale at which to start solving
-        std::vector<std::string> scrambleSequence;
-        std::vector<std::string> solveSequence;
+        std::vector<uint8_t> scrambleSequence;
+        cubiecube_t scrambleState;  // scrambleSequence compiled into one cube
+        std::vector<uint8_t> solveSequence;
         
         GrowingCubeAnimation() :
             isActive(false),
@@ -989,6 +991,9 @@ private:
         }
 
         angle = normalizeAngle(angle);
+        int mv = parseMove(std::string_view(&face, 1));
+        if (mv >= 0)
+            appendMove(&faceState, angle < 0 ? mv : mv + 2);
         // Setup animation
         currentAnimation.face = face;
         currentAnimation.targetAngle = angle;
@@ -1200,6 +1205,7 @@ public:
         
         std::cout << "Rubik's Cube Constructor" << std::endl;
         camera = &cam;
+        clear_moves(&faceState);
         //initializeCubes();
         //setupBuffers();
     }
@@ -1227,6 +1233,7 @@ public:
         }
         // set isExecutingSequence to false
         isExecutingSequence = false;
+        clear_moves(&faceState);
         // initialize cubes
         initializeCubes();
         // setup buffers
@@ -1449,9 +1456,11 @@ public:
         std::vector<Move> scrmblSeq = generateScrambleSequence(15);
         // store scrmblSeq in growingCube
         for(auto move : scrmblSeq){
-            std::string str = std::string(1, move.face);
-            growingCube.scrambleSequence.push_back(str);
+            int mv = parseMove(std::string_view(&move.face, 1));
+            if (mv >= 0) // slice moves are not part of the solver notation
+                growingCube.scrambleSequence.push_back(mv);
         }
+        compileSequence(growingCube.scrambleSequence.data(), (long)growingCube.scrambleSequence.size(), &growingCube.scrambleState);
         // Store reverse of scramble for solve sequence
         //growingCube.solveSequence = get_solution(to_cube_not(growingCube.scrambleSequence));
         growingCube.solveSequence.clear();
@@ -1489,10 +1498,10 @@ public:
                 if (growingCube.startedScrambling && !secondaryCube->isExecutingSequence && !growingCube.finishedScrambling) {
                     growingCube.finishedScrambling = true;
                     // Generate solve sequence only after scramble is complete
-                    string scrambledState = to_cube_not(growingCube.scrambleSequence);
+                    string scrambledState = to_cube_not(&growingCube.scrambleState);
                     growingCube.solveSequence = get_solution(scrambledState);
                     for(int i=0;i<growingCube.solveSequence.size();++i){
-                        std::cout<<growingCube.solveSequence[i]<<" ";
+                        std::cout<<moveName(growingCube.solveSequence[i])<<" ";
                     }
                     std::cout << std::endl;
                 }
@@ -1720,8 +1729,8 @@ public:
         rotateSlice('S', -90.0f);
     }
 
-    std::vector<string> scrambleCube(int numMoves) {
-        std::vector<std::string> sequenceString;
+    std::vector<uint8_t> scrambleCube(int numMoves) {
+        std::vector<uint8_t> sequenceString;
         std::vector<Move> scrambleSequence = generateScrambleSequence(numMoves);
 
         isExecutingSequence = true;
@@ -1731,233 +1740,77 @@ public:
         for (const Move& move : scrambleSequence) {
             std::cout << move.face << "(" << move.angle << ") ";
         
-            // if (move.isSlice) {
-            //     rotateSlice(move.face, move.angle);
-            // } else {
-            //     rotateFace(move.face, move.angle);
-            // }
             currentAnimation.animationSpeed = 720.0f;
-            if(move.angle < 0)
-            {
-                switch(move.face) {
-                    case 'U':
-                        queueRotation('U', -90.0f);
-                        sequenceString.push_back("U");
-                        //rotateU();
-                        //sequenceString.push_back("U");
-                        break;
-                    case 'L':
-                        queueRotation('L', -90.0f);
-                        sequenceString.push_back("L");
-                        //rotateL();
-                        //sequenceString.push_back("L");
-                        break;
-                    case 'F':
-                        queueRotation('F', -90.0f);
-                        sequenceString.push_back("F");
-                        //rotateF();
-                        //sequenceString.push_back("F");
-                        break;
-                    case 'R':
-                        queueRotation('R', -90.0f);
-                        sequenceString.push_back("R");
-                        //rotateR();
-                        //sequenceString.push_back("R");
-                        break;
-                    case 'B':
-                        queueRotation('B', -90.0f);
-                        sequenceString.push_back("B");
-                        //rotateB();
-                        //sequenceString.push_back("B");
-                        break;
-                    case 'D':
-                        queueRotation('D', -90.0f);
-                        sequenceString.push_back("D");
-                        //rotateD();
-                        //sequenceString.push_back("D");
-                        break;
-                    case 'V':
-                        rotateSV();
-                        break;
-                    case 'H':
-                        rotateSH();
-                        break;
-                    case 'S':
-                        rotateSS();
-                        break;
-                }
-            }
-            else{
-                switch(move.face) {
-                    case 'U':
-                        queueRotation('U', 90.0f);
-                        sequenceString.push_back("U'");	
-                        //rotateUPrime();
-                        //sequenceString.push_back("U'");
-                        break;
-                    case 'L':
-                        queueRotation('L', 90.0f);
-                        sequenceString.push_back("L'");
-                        //rotateLPrime();
-                        //sequenceString.push_back("L'");
-                        break;
-                    case 'F':
-                        queueRotation('F', 90.0f);
-                        sequenceString.push_back("F'");
-                        //rotateFPrime();
-                        //sequenceString.push_back("F'");
-                        break;
-                    case 'R':
-                        queueRotation('R', 90.0f);
-                        sequenceString.push_back("R'");
-                        //rotateRPrime();
-                        //sequenceString.push_back("R'");
-                        break;
-                    case 'B':
-                        queueRotation('B', 90.0f);
-                        sequenceString.push_back("B'");
-                        //rotateBPrime();
-                        //sequenceString.push_back("B'");
-                        break;
-                    case 'D':
-                        queueRotation('D', 90.0f);
-                        sequenceString.push_back("D'");
-                        //rotateDPrime();
-                        //sequenceString.push_back("D'");
-                        break;
-                    case 'V':
-                        rotateSV();
-                        break;
-                    case 'H':
-                        rotateSH();
-                        break;
-                    case 'S':
-                        rotateSS();
-                        break;
-                }
+            switch(move.face) {
+                case 'V':
+                    rotateSV();
+                    break;
+                case 'H':
+                    rotateSH();
+                    break;
+                case 'S':
+                    rotateSS();
+                    break;
+                default:
+                    {
+                        int mv = parseMove(std::string_view(&move.face, 1));
+                        if (mv < 0)
+                            break;
+                        if(move.angle < 0)
+                        {
+                            queueRotation(move.face, -90.0f);
+                            sequenceString.push_back(mv);
+                        }
+                        else
+                        {
+                            queueRotation(move.face, 90.0f);
+                            sequenceString.push_back(mv + 2); // prime
+                        }
+                    }
+                    break;
             }
-            
         }
         //std::cout << "queue size: "<< moveQueue.size() << std::endl;
         std::cout << std::endl;
         return sequenceString;
     }
 
-    void moveFromList(std::vector<std::string> str)
+    void moveFromList(const std::vector<uint8_t>& moves)
     {
-        std::string mov = "";
-
         emptyMoveQueue();
         //std::cout << "queue size: "<< moveQueue.size() << std::endl;
         isExecutingSequence = true;
-        std::cout << "Executing from list:" << str.size() <<std::endl;
+        std::cout << "Executing from list:" << moves.size() <<std::endl;
         // print the moves
-        for(int i=0;i<str.size();++i){
-            std::cout<<str[i]<<" ";
+        for(uint8_t mv : moves){
+            std::cout<<moveName(mv)<<" ";
         }
         std::cout << std::endl;
 
-        while(!(str.empty())){
+        for(uint8_t mv : moves){
+            char face = moveName(mv)[0];
             currentAnimation.animationSpeed = 180.0f;
-            mov = str[0];
-            str.erase(str.begin());
-            if(mov == "U")
-            {
-                queueRotation('U', -90.0f);
-            }
-            else if(mov == "U'")
-            {
-                queueRotation('U', 90.0f); 
-            }
-            else if(mov == "U2")
-            {
-                //rotateU2();
-                queueRotation('U', -90.0f);
-                queueRotation('U', -90.0f);
-            }
-            else if(mov == "L")
-            {
-                //rotateL();
-                queueRotation('L', -90.0f);
-            }
-            else if(mov == "L'")
-            {
-                //rotateLPrime();
-                queueRotation('L', 90.0f);
-            }
-            else if(mov == "L2")
-            {
-                //rotateL2();
-                queueRotation('L', -90.0f);
-                queueRotation('L', -90.0f);
-            }
-            else if(mov == "F")
-            {
-                //rotateF();
-                queueRotation('F', -90.0f);
-            }
-            else if(mov == "F'")
-            {
-                //rotateFPrime();
-                queueRotation('F', 90.0f);
-            }
-            else if(mov == "F2")
-            {
-                //rotateF2();
-                queueRotation('F', -90.0f);
-                queueRotation('F', -90.0f);
-            }
-            else if(mov == "R")
-            {
-                //rotateR();
-                queueRotation('R', -90.0f);
-            }
-            else if(mov == "R'")
-            {
-                //rotateRPrime();
-                queueRotation('R', 90.0f);
-            }
-            else if(mov == "R2")
-            {
-                //rotateR2();
-                queueRotation('R', -90.0f);
-                queueRotation('R', -90.0f);
-            }
-            else if(mov == "B")
-            {
-                //rotateB();
-                queueRotation('B', -90.0f);
-            }
-            else if(mov == "B'")
-            {
-                //rotateBPrime();
-                queueRotation('B', 90.0f);
-            }
-            else if(mov == "B2")
-            {
-                //rotateB2();
-                queueRotation('B', -90.0f);
-                queueRotation('B', -90.0f);
-            }
-            else if(mov == "D")
-            {
-                //rotateD();
-                queueRotation('D', -90.0f);
-            }
-            else if(mov == "D'")
-            {
-                //rotateDPrime();
-                queueRotation('D', 90.0f);
-            }
-            else if(mov == "D2")
-            {
-                //rotateD2();
-                queueRotation('D', -90.0f);
-                queueRotation('D', -90.0f);
+            switch(mv % 3) {
+                case 0: // clockwise
+                    queueRotation(face, -90.0f);
+                    break;
+                case 1: // half turn
+                    queueRotation(face, -90.0f);
+                    queueRotation(face, -90.0f);
+                    break;
+                case 2: // counterclockwise
+                    queueRotation(face, 90.0f);
+                    break;
             }
         }
     }
 
+    // State of the cube after the face turn which is animated right now. Queued turns are not included, a new
+    // move list drops them.
+    cubiecube_t* getState() {
+        return &faceState;
+    }
+
     void setLastFrameTime(float time) {
         lastFrameTime = time;
     }
@@ -0,0 +1,450 @@
+#include <stdio.h>
+#include <string.h>
+#include "bigcube.h"
+
+// One of the 4 strips of a layer turn: the strip of srcFace moves to the strip of dstFace. A strip is a row or a
+// column whose index is the layer (outer = 0) or N - 1 - layer (outer = 1), seen from the face of the axis.
+// reversed strips are turned around on the way.
+typedef struct {
+    uint8_t srcFace, srcRow, srcOuter;
+    uint8_t dstFace, dstRow, dstOuter;
+    uint8_t reversed;
+} strip_t;
+
+// strips[axis][power - 1] for turns about the axes of U, R and F
+typedef struct {
+    strip_t strips[3][3][4];
+} layout_t;
+
+static const int faceNormal[6][3] = { {0, 1, 0}, {1, 0, 0}, {0, 0, 1}, {0, -1, 0}, {-1, 0, 0}, {0, 0, -1} };
+
+// Position of a facelet with twice the coordinates, so that the centers of the facelets are integers: the face is at
+// +-n on its axis and the facelets at -(n - 1), -(n - 3), ..., n - 1 on the other two.
+static void faceletPosition(int face, int r, int c, int n, int v[3])
+{
+    int a = 2 * c - (n - 1), b = 2 * r - (n - 1);// to the right and down, seen from outside
+    switch (face) {
+    case 0: v[0] = a; v[1] = n; v[2] = b; break;
+    case 1: v[0] = n; v[1] = -b; v[2] = -a; break;
+    case 2: v[0] = a; v[1] = -b; v[2] = n; break;
+    case 3: v[0] = a; v[1] = -n; v[2] = -b; break;
+    case 4: v[0] = -n; v[1] = -b; v[2] = a; break;
+    default: v[0] = -a; v[1] = -b; v[2] = -n; break;
+    }
+}
+
+static void findFacelet(const int v[3], int n, int* face, int* r, int* c)
+{
+    int w[3];
+    for (*face = 0; *face < 6; (*face)++)
+        for (*r = 0; *r < n; (*r)++)
+            for (*c = 0; *c < n; (*c)++) {
+                faceletPosition(*face, *r, *c, n, w);
+                if (w[0] == v[0] && w[1] == v[1] && w[2] == v[2])
+                    return;
+            }
+}
+
+// Quarter turn clockwise seen from the face with normal a: v' = -(a x v) + a (a . v)
+static void rotateClockwise(const int a[3], int v[3])
+{
+    int dot = a[0] * v[0] + a[1] * v[1] + a[2] * v[2];
+    int x = -(a[1] * v[2] - a[2] * v[1]) + a[0] * dot;
+    int y = -(a[2] * v[0] - a[0] * v[2]) + a[1] * dot;
+    int z = -(a[0] * v[1] - a[1] * v[0]) + a[2] * dot;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+}
+
+// The strips are the same for every N, they are found by turning the second layer of a 5x5 cube
+static const layout_t* layout(void)
+{
+    static const layout_t table = [] {
+        const int n = 5, layer = 1;
+        layout_t t;
+        memset(&t, 0, sizeof(t));
+        for (int axis = 0; axis < 3; axis++)
+            for (int power = 1; power <= 3; power++) {
+                const int* a = faceNormal[axis];
+                int k = 0;
+                for (int face = 0; face < 6; face++) {
+                    int v[3], found = 0, rowIndex = -1, colIndex = -1;
+                    for (int r = 0; r < n; r++)
+                        for (int c = 0; c < n; c++) {
+                            faceletPosition(face, r, c, n, v);
+                            if (a[0] * v[0] + a[1] * v[1] + a[2] * v[2] != n - 1 - 2 * layer)
+                                continue;
+                            // every facelet of a side face in the layer has the same row or the same column
+                            rowIndex = found == 0 || rowIndex == r ? r : -1;
+                            colIndex = found == 0 || colIndex == c ? c : -1;
+                            found++;
+                        }
+                    if (found != n)
+                        continue;
+                    strip_t* s = &t.strips[axis][power - 1][k++];
+                    int index = rowIndex >= 0 ? rowIndex : colIndex;
+                    s->srcFace = (uint8_t) face;
+                    s->srcRow = rowIndex >= 0;
+                    s->srcOuter = index != layer;
+                    // follow the first facelet of the strip
+                    int dstFace, dr, dc;
+                    if (rowIndex >= 0)
+                        faceletPosition(face, rowIndex, 0, n, v);
+                    else
+                        faceletPosition(face, 0, colIndex, n, v);
+                    for (int p = 0; p < power; p++)
+                        rotateClockwise(a, v);
+                    findFacelet(v, n, &dstFace, &dr, &dc);
+                    // the second facelet tells if the strip is a row or a column there
+                    int w[3], dstFace2, dr2, dc2;
+                    if (rowIndex >= 0)
+                        faceletPosition(face, rowIndex, 1, n, w);
+                    else
+                        faceletPosition(face, 1, colIndex, n, w);
+                    for (int p = 0; p < power; p++)
+                        rotateClockwise(a, w);
+                    findFacelet(w, n, &dstFace2, &dr2, &dc2);
+                    s->dstFace = (uint8_t) dstFace;
+                    s->dstRow = dr2 == dr;
+                    s->dstOuter = (s->dstRow ? dr : dc) != layer;
+                    s->reversed = (s->dstRow ? dc2 < dc : dr2 < dr);
+                }
+            }
+        return t;
+    }();
+    return &table;
+}
+
+static inline uint64_t reverseBits(uint64_t w, int n)
+{
+    w = (w >> 1 & 0x5555555555555555ULL) | (w & 0x5555555555555555ULL) << 1;
+    w = (w >> 2 & 0x3333333333333333ULL) | (w & 0x3333333333333333ULL) << 2;
+    w = (w >> 4 & 0x0F0F0F0F0F0F0F0FULL) | (w & 0x0F0F0F0F0F0F0F0FULL) << 4;
+    w = (w >> 8 & 0x00FF00FF00FF00FFULL) | (w & 0x00FF00FF00FF00FFULL) << 8;
+    w = (w >> 16 & 0x0000FFFF0000FFFFULL) | (w & 0x0000FFFF0000FFFFULL) << 16;
+    w = w >> 32 | w << 32;
+    return w >> (64 - n);
+}
+
+// Transpose the size x size bit matrix in rows, bit c of row r is the entry (r, c). size is a power of 2.
+static void transposeBits(uint64_t* rows, int size)
+{
+    static const uint64_t masks[6] = { 0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+            0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL };
+    int j, k, level = 0;
+    for (j = 1; j < size / 2; j <<= 1)
+        level++;
+    for (j = size / 2; j != 0; j >>= 1, level--)
+        for (k = 0; k < size; k = (k + j + 1) & ~j) {
+            uint64_t t = (rows[k] >> j ^ rows[k + j]) & masks[level];
+            rows[k] ^= t << j;
+            rows[k + j] ^= t;
+        }
+}
+
+// Turn the facelets of the face itself, power quarter turns clockwise
+static void rotateFace(bigcube_t* cube, int face, int power)
+{
+    int n = cube->n, size = 2, b, r;
+    uint64_t tmp[64];
+    while (size < n)
+        size <<= 1;
+    for (b = 0; b < 3; b++) {
+        uint64_t* rows = cube->plane[face][b];
+        if (power == 2) {
+            for (r = 0; r < n / 2; r++) {
+                uint64_t t = rows[r];
+                rows[r] = reverseBits(rows[n - 1 - r], n);
+                rows[n - 1 - r] = reverseBits(t, n);
+            }
+            if (n & 1)
+                rows[n / 2] = reverseBits(rows[n / 2], n);
+            continue;
+        }
+        // clockwise: new (r, c) = old (n - 1 - c, r), the transposition of the rows in reverse order
+        for (r = 0; r < n; r++)
+            tmp[r] = rows[power == 1 ? n - 1 - r : r];
+        for (r = n; r < size; r++)
+            tmp[r] = 0;
+        transposeBits(tmp, size);
+        for (r = 0; r < n; r++)
+            rows[r] = tmp[power == 1 ? r : n - 1 - r];
+    }
+}
+
+// Turn one layer about the axis of face U, R or F (0..2), layer counted from that face
+static void turnLayer(bigcube_t* cube, int axis, int layer, int power)
+{
+    const strip_t* strips = layout()->strips[axis][power - 1];
+    uint64_t tmp[4][3];
+    int n = cube->n, k, b, r;
+
+    for (k = 0; k < 4; k++) {
+        const strip_t* s = &strips[k];
+        int index = s->srcOuter ? n - 1 - layer : layer;
+        const uint64_t (*planes)[BIG_MAX_N] = cube->plane[s->srcFace];
+        if (s->srcRow) {
+            for (b = 0; b < 3; b++)
+                tmp[k][b] = planes[b][index];
+        } else {
+            uint64_t w0 = 0, w1 = 0, w2 = 0;
+            for (r = 0; r < n; r++) {
+                w0 |= (planes[0][r] >> index & 1) << r;
+                w1 |= (planes[1][r] >> index & 1) << r;
+                w2 |= (planes[2][r] >> index & 1) << r;
+            }
+            tmp[k][0] = w0;
+            tmp[k][1] = w1;
+            tmp[k][2] = w2;
+        }
+        if (s->reversed)
+            for (b = 0; b < 3; b++)
+                tmp[k][b] = reverseBits(tmp[k][b], n);
+    }
+    for (k = 0; k < 4; k++) {
+        const strip_t* s = &strips[k];
+        int index = s->dstOuter ? n - 1 - layer : layer;
+        uint64_t (*planes)[BIG_MAX_N] = cube->plane[s->dstFace];
+        if (s->dstRow) {
+            for (b = 0; b < 3; b++)
+                planes[b][index] = tmp[k][b];
+        } else {
+            uint64_t keep = ~(1ULL << index);
+            for (r = 0; r < n; r++) {
+                planes[0][r] = (planes[0][r] & keep) | (tmp[k][0] >> r & 1) << index;
+                planes[1][r] = (planes[1][r] & keep) | (tmp[k][1] >> r & 1) << index;
+                planes[2][r] = (planes[2][r] & keep) | (tmp[k][2] >> r & 1) << index;
+            }
+        }
+    }
+    if (layer == 0)
+        rotateFace(cube, axis, power);
+    if (layer == n - 1)// the opposite face turns the other way seen from its own side
+        rotateFace(cube, axis + 3, 4 - power);
+}
+
+int initBigCube(bigcube_t* cube, int n)
+{
+    int face, b, r;
+    if (n < BIG_MIN_N || n > BIG_MAX_N)
+        return -1;
+    memset(cube, 0, sizeof(bigcube_t));
+    cube->n = n;
+    for (face = 0; face < 6; face++)
+        for (b = 0; b < 3; b++)
+            for (r = 0; r < n; r++)
+                cube->plane[face][b][r] = face >> b & 1 ? (~0ULL >> (64 - n)) : 0;
+    return 0;
+}
+
+int bigIsSolved(const bigcube_t* cube)
+{
+    int n = cube->n, face, b, r;
+    for (face = 0; face < 6; face++)
+        for (b = 0; b < 3; b++)
+            for (r = 0; r < n; r++)
+                if (cube->plane[face][b][r] != cube->plane[face][b][0])
+                    return 0;
+    for (face = 0; face < 6; face++)
+        for (b = 0; b < 3; b++) {
+            uint64_t w = cube->plane[face][b][0];
+            if (w != 0 && w != ~0ULL >> (64 - n))
+                return 0;
+        }
+    return 1;
+}
+
+int getBigFacelet(const bigcube_t* cube, int face, int r, int c)
+{
+    int b, color = 0;
+    for (b = 0; b < 3; b++)
+        color |= (int) (cube->plane[face][b][r] >> c & 1) << b;
+    return color;
+}
+
+void setBigFacelet(bigcube_t* cube, int face, int r, int c, int color)
+{
+    int b;
+    for (b = 0; b < 3; b++)
+        cube->plane[face][b][r] = (cube->plane[face][b][r] & ~(1ULL << c)) | (uint64_t) (color >> b & 1) << c;
+}
+
+void bigToString(const bigcube_t* cube, char* res)
+{
+    int n = cube->n, face, r, c, i = 0;
+    for (face = 0; face < 6; face++)
+        for (r = 0; r < n; r++)
+            for (c = 0; c < n; c++) {
+                int color = getBigFacelet(cube, face, r, c);
+                res[i++] = color < 6 ? "URFDLB"[color] : '?';
+            }
+    res[i] = '\0';
+}
+
+int bigFromString(bigcube_t* cube, int n, std::string_view facelets)
+{
+    int face, r, c, i = 0;
+    if (initBigCube(cube, n) != 0 || facelets.size() != (size_t) (6 * n * n))
+        return -1;
+    for (face = 0; face < 6; face++)
+        for (r = 0; r < n; r++)
+            for (c = 0; c < n; c++) {
+                const char* p = (const char*) memchr("URFDLB", facelets[i++], 6);
+                if (p == NULL)
+                    return -1;
+                setBigFacelet(cube, face, r, c, (int) (p - "URFDLB"));
+            }
+    return 0;
+}
+
+void bigApply(bigcube_t* cube, bigmove_t move)
+{
+    int n = cube->n, layer;
+    if (move.face < 3) {
+        for (layer = move.first; layer <= move.last; layer++)
+            turnLayer(cube, move.face, layer, move.power);
+    } else {// a D, L or B turn is the other way round seen from U, R or F
+        for (layer = n - 1 - move.last; layer <= n - 1 - move.first; layer++)
+            turnLayer(cube, move.face - 3, layer, 4 - move.power);
+    }
+}
+
+void bigApplyMoves(bigcube_t* cube, const bigmove_t* moves, int count)
+{
+    int n = cube->n, i = 0;
+    int power[BIG_MAX_N];
+    while (i < count) {
+        // the turns about one axis commute, the quarter turns of each layer are summed up over the whole run
+        int axis = moves[i].face % 3, layer;
+        memset(power, 0, sizeof(power));
+        for (; i < count && moves[i].face % 3 == axis; i++) {
+            const bigmove_t* m = &moves[i];
+            for (layer = m->first; layer <= m->last; layer++)
+                if (m->face < 3)
+                    power[layer] += m->power;
+                else
+                    power[n - 1 - layer] += 4 - m->power;
+        }
+        for (layer = 0; layer < n; layer++)
+            if (power[layer] & 3)
+                turnLayer(cube, axis, layer, power[layer] & 3);
+    }
+}
+
+int parseBigMove(std::string_view token, int n, bigmove_t* move)
+{
+    static const char faces[] = "URFDLB";
+    size_t i = 0;
+    int first = 0, last = 0, prefix = 0, wide = 0;
+    const char* p;
+
+    if (token.empty())
+        return -1;
+    if (token[0] >= '0' && token[0] <= '9') {
+        // no layer number is above BIG_MAX_N, longer numbers are rejected before they overflow
+        for (; i < token.size() && token[i] >= '0' && token[i] <= '9'; i++)
+            if ((first = 10 * first + token[i] - '0') > BIG_MAX_N)
+                return -1;
+        last = first;
+        if (i < token.size() && token[i] == '-') {
+            last = 0;
+            for (i++; i < token.size() && token[i] >= '0' && token[i] <= '9'; i++)
+                if ((last = 10 * last + token[i] - '0') > BIG_MAX_N)
+                    return -1;
+            prefix = 2;
+        } else {
+            prefix = 1;
+        }
+        if (first < 1 || last < first || last > n)
+            return -1;
+    }
+    if (i == token.size())
+        return -1;
+
+    if (token[i] == 'M' || token[i] == 'E' || token[i] == 'S') {
+        if (prefix != 0 || (n & 1) == 0)
+            return -1;
+        move->face = (uint8_t) (token[i] == 'M' ? 4 : token[i] == 'E' ? 3 : 2);
+        move->first = move->last = (uint8_t) (n / 2);
+    } else if ((p = (const char*) memchr(faces, token[i], 6)) != NULL) {
+        move->face = (uint8_t) (p - faces);
+        if (i + 1 < token.size() && token[i + 1] == 'w') {
+            wide = 1;
+            i++;
+        }
+    } else {
+        const char lower[] = "urfdlb";
+        if ((p = (const char*) memchr(lower, token[i], 6)) == NULL)
+            return -1;
+        move->face = (uint8_t) (p - lower);
+        wide = 1;
+    }
+    i++;
+    if (token[i - 1] != 'M' && token[i - 1] != 'E' && token[i - 1] != 'S') {
+        if (wide && prefix == 2)
+            return -1;
+        if (wide) {// nRw are the n outer layers
+            move->first = 0;
+            move->last = (uint8_t) (prefix ? first - 1 : 1);
+            if (move->last >= n)
+                return -1;
+        } else {
+            move->first = (uint8_t) (prefix ? first - 1 : 0);
+            move->last = (uint8_t) (prefix ? last - 1 : 0);
+        }
+    }
+
+    std::string_view suffix = token.substr(i);
+    if (suffix.empty())
+        move->power = 1;
+    else if (suffix == "2" || suffix == "2'")
+        move->power = 2;
+    else if (suffix == "'")
+        move->power = 3;
+    else
+        return -1;
+    return 0;
+}
+
+int parseBigMoves(std::string_view text, int n, bigmove_t* moves, int capacity)
+{
+    size_t i = 0;
+    int count = 0;
+    while (i < text.size()) {
+        size_t j;
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' || text[i] == '\n'))
+            i++;
+        for (j = i; j < text.size() && text[j] != ' ' && text[j] != '\t' && text[j] != '\r' && text[j] != '\n'; j++)
+            ;
+        if (j == i)
+            break;
+        if (count == capacity || parseBigMove(text.substr(i, j - i), n, &moves[count]) != 0)
+            return -1;
+        count++;
+        i = j;
+    }
+    return count;
+}
+
+int formatBigMove(bigmove_t move, char* out)
+{
+    static const char faces[] = "URFDLB";
+    static const char* suffix[4] = { "", "", "2", "'" };
+    char face = faces[move.face % 6];
+    if (move.first == 0 && move.last == 0)
+        return snprintf(out, 12, "%c%s", face, suffix[move.power & 3]);
+    if (move.first == move.last)
+        return snprintf(out, 12, "%d%c%s", move.first + 1, face, suffix[move.power & 3]);
+    if (move.first == 0 && move.last == 1)
+        return snprintf(out, 12, "%cw%s", face, suffix[move.power & 3]);
+    if (move.first == 0)
+        return snprintf(out, 12, "%d%cw%s", move.last + 1, face, suffix[move.power & 3]);
+    return snprintf(out, 12, "%d-%d%c%s", move.first + 1, move.last + 1, face, suffix[move.power & 3]);
+}
+
+bigmove_t invertBigMove(bigmove_t move)
+{
+    move.power = (uint8_t) (4 - move.power);
+    return move;
+}
@@ -0,0 +1,73 @@
+#ifndef BIGCUBE_H
+#define BIGCUBE_H
+
+#include <stdint.h>
+#include <string_view>
+
+// State of an NxN cube, 2 <= N <= 33, on the facelet level.
+// The faces are U, R, F, D, L, B in this order, each one a grid of N rows and N columns seen from outside like in
+// the net of facelet.h, so for N = 3 the facelets are in the order of the cube definition string. The colours are
+// 0..5 for U..B. They are stored bit-sliced: plane[face][b][row] holds bit b of the colours of one row, column c
+// in bit c. A layer turn moves 4 strips of N facelets, a row strip is 3 words, a column strip is gathered from and
+// scattered to the bits of N rows. Turning an outer layer also rotates its face, which is a transposition of the
+// 3 bit matrices.
+
+#define BIG_MIN_N 2
+#define BIG_MAX_N 33
+
+typedef struct {
+    int n;
+    uint64_t plane[6][3][BIG_MAX_N];
+} bigcube_t;
+
+// A turn of the layers first..last of a face, counted from that face starting at 0, power quarter turns clockwise
+// seen from the face (1, 2 or 3). face is 0..5 for U, R, F, D, L, B.
+typedef struct {
+    uint8_t face;
+    uint8_t first;
+    uint8_t last;
+    uint8_t power;
+} bigmove_t;
+
+// The solved cube of size n. Returns -1 if n is out of range.
+int initBigCube(bigcube_t* cube, int n);
+
+int bigIsSolved(const bigcube_t* cube);
+
+// Colour of the facelet in row r and column c of face
+int getBigFacelet(const bigcube_t* cube, int face, int r, int c);
+void setBigFacelet(bigcube_t* cube, int face, int r, int c, int color);
+
+// The 6 * N * N colours as "URFDLB" letters face by face, row by row, and a terminating 0. For N = 3 this is the
+// cube definition string. bigFromString returns -1 if the length or a letter is wrong, the colours are not checked.
+void bigToString(const bigcube_t* cube, char* res);
+int bigFromString(bigcube_t* cube, int n, std::string_view facelets);
+
+// Apply one move. The layers must be below N.
+void bigApply(bigcube_t* cube, bigmove_t move);
+
+// Apply count moves. The quarter turns of each layer are added up over a run of moves about the same axis before any
+// layer is turned, so e.g. "R L' R" turns the R layer once by a half turn and the L layer once, and "Rw R'" turns
+// only the second layer.
+void bigApplyMoves(bigcube_t* cube, const bigmove_t* moves, int count);
+
+// Move notation for N layers:
+//   R, R2, R', R2'   the outer layer of a face, like notation.h
+//   3R               the third layer from R alone, an inner slice
+//   2-4R             the layers 2 to 4
+//   Rw, 3Rw, r       the 2 (or 3) outer layers together, r is Rw
+//   M, E, S          the middle layer in the direction of L, D and F, only for odd N
+// Returns 0 and fills move, or -1 if the token is no move for N layers.
+int parseBigMove(std::string_view token, int n, bigmove_t* move);
+
+// Parse moves separated by white space. Returns the number of moves or -1 if a token is not a move or there are more
+// than capacity.
+int parseBigMoves(std::string_view text, int n, bigmove_t* moves, int capacity);
+
+// Write the move in the notation above to out, which needs room for 12 characters. Returns the length.
+int formatBigMove(bigmove_t move, char* out);
+
+// The inverse of a move
+bigmove_t invertBigMove(bigmove_t move);
+
+#endif
@@ -292,8 +292,7 @@ short cornerParity(cubiecube_t* cubiecube)
     int s = 0;
     for (i = DRB; i >= URF + 1; i--)
         for (j = i - 1; j >= URF; j--)
-            if (cubiecube->cp[j] > cubiecube->cp[i])
-                s++;
+            s += cubiecube->cp[j] > cubiecube->cp[i];// no branch, the comparisons are unpredictable
     return (short) (s % 2);
 }
 
@@ -303,8 +302,7 @@ short edgeParity(cubiecube_t* cubiecube)
     int s = 0;
     for (i = BR; i >= UR + 1; i--)
         for (j = i - 1; j >= UR; j--)
-            if (cubiecube->ep[j] > cubiecube->ep[i])
-                s++;
+            s += cubiecube->ep[j] > cubiecube->ep[i];
     return (short) (s % 2);
 }
 
@@ -589,13 +587,17 @@ int getURFtoDLB(cubiecube_t* cubiecube)
 void setURFtoDLB(cubiecube_t* cubiecube, int idx)
 {
     corner_t perm[8] = { URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB };
-    int k, j;
+    int i, k, j;
     int x = 7;// set corners
     for (j = 1; j < 8; j++) {
         k = idx % (j + 1);
         idx /= j + 1;
-        while (k-- > 0)
-            rotateRight_corner(perm, 0, j);
+        if (k > 0) {// k right rotations of perm[0..j] in one pass
+            corner_t tmp[8];
+            memcpy(tmp, perm, sizeof(tmp));
+            for (i = 0; i <= j; i++)
+                perm[i] = tmp[i >= k ? i - k : i + j + 1 - k];
+        }
     }
 
     for (j = 7; j >= 0; j--)
@@ -623,13 +625,17 @@ int getURtoBR(cubiecube_t* cubiecube)
 void setURtoBR(cubiecube_t* cubiecube, int idx)
 {
     edge_t perm[12] = { UR, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR };
-    int k, j;
+    int i, k, j;
     int x = 11;// set edges
     for (j = 1; j < 12; j++) {
         k = idx % (j + 1);
         idx /= j + 1;
-        while (k-- > 0)
-            rotateRight_edge(perm, 0, j);
+        if (k > 0) {// k right rotations of perm[0..j] in one pass
+            edge_t tmp[12];
+            memcpy(tmp, perm, sizeof(tmp));
+            for (i = 0; i <= j; i++)
+                perm[i] = tmp[i >= k ? i - k : i + j + 1 - k];
+        }
     }
     for (j = 11; j >= 0; j--)
         cubiecube->ep[j] = perm[x--];
@@ -670,6 +676,30 @@ int verify(cubiecube_t* cubiecube)
     return 0;// cube ok
 }
 
+void getCubieKey(cubiecube_t* cubiecube, cubiekey_t* key)
+{
+    int i;
+    key->corners = 0;
+    key->edges = 0;
+    for (i = CORNER_COUNT - 1; i >= 0; i--)
+        key->corners = (key->corners << 5) | (uint64_t) (cubiecube->cp[i] << 2 | cubiecube->co[i]);
+    for (i = EDGE_COUNT - 1; i >= 0; i--)
+        key->edges = (key->edges << 5) | (uint64_t) (cubiecube->ep[i] << 1 | cubiecube->eo[i]);
+}
+
+void setCubieKey(cubiecube_t* cubiecube, cubiekey_t* key)
+{
+    int i;
+    for (i = 0; i < CORNER_COUNT; i++) {
+        cubiecube->cp[i] = (corner_t) (key->corners >> (5 * i + 2) & 7);
+        cubiecube->co[i] = (signed char) (key->corners >> (5 * i) & 3);
+    }
+    for (i = 0; i < EDGE_COUNT; i++) {
+        cubiecube->ep[i] = (edge_t) (key->edges >> (5 * i + 1) & 15);
+        cubiecube->eo[i] = (signed char) (key->edges >> (5 * i) & 1);
+    }
+}
+
 int getURtoDF_standalone(short idx1, short idx2)
 {
     int res, i;
@@ -3,6 +3,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "corner.h" 
 #include "edge.h"
@@ -21,6 +22,14 @@ struct cubiecube {
 };
 typedef struct cubiecube cubiecube_t;
 
+// Compact encoding of a cube, two cubes are equal if and only if their keys are equal.
+// corners holds permutation and orientation of the corners (5 bits per corner position, 40 bits), edges holds
+// permutation and orientation of the edges (5 bits per edge position, 60 bits). The upper bits are 0.
+typedef struct {
+    uint64_t corners;
+    uint64_t edges;
+} cubiekey_t;
+
 // forward declaration
 struct facecube;
 
@@ -63,6 +72,9 @@ void setURtoBR(cubiecube_t* cubiecube, int idx);
 
 int verify(cubiecube_t* cubiecube);
 
+void getCubieKey(cubiecube_t* cubiecube, cubiekey_t* key);
+void setCubieKey(cubiecube_t* cubiecube, cubiekey_t* key);
+
 int getURtoDF_standalone(short idx1, short idx2);
 
 #endif
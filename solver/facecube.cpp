@@ -81,6 +81,21 @@ void to_String(facecube_t* facecube, char* res)
     res[54] = 0;
 }
 
+void cubieToString(cubiecube_t* cubiecube, char* res)
+{
+    static const char colors[] = "URFDLB";
+    int i, n;
+    for (i = 0; i < 54; i += 9)// centers
+        res[i + 4] = colors[i / 9];
+    for (i = 0; i < CORNER_COUNT; i++)
+        for (n = 0; n < 3; n++)
+            res[cornerFacelet[i][(n + cubiecube->co[i]) % 3]] = colors[cornerColor[cubiecube->cp[i]][n]];
+    for (i = 0; i < EDGE_COUNT; i++)
+        for (n = 0; n < 2; n++)
+            res[edgeFacelet[i][(n + cubiecube->eo[i]) % 2]] = colors[edgeColor[cubiecube->ep[i]][n]];
+    res[54] = 0;
+}
+
 cubiecube_t* toCubieCube(facecube_t* facecube)
 {
     int i, j;
@@ -36,6 +36,8 @@ facecube_t* get_facecube(void);
 facecube_t* get_facecube_fromstring(char* cubeString);
 
 void to_String(facecube_t* facecube, char* res);
+// Cube definition string of a cube on the cubie level, same as toFaceCube and to_String without the allocation
+void cubieToString(struct cubiecube* cubiecube, char* res);
 struct cubiecube* toCubieCube(facecube_t* facecube);
 
 #endif
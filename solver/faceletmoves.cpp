@@ -0,0 +1,147 @@
+#include <string.h>
+#include <atomic>
+#include "faceletmoves.h"
+#include "facecube.h"
+#include "sequence.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FACELETS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TARGET_SSSE3
+#else
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#endif
+
+void faceletPermFromCubie(cubiecube_t* cubiecube, faceletperm_t* perm)
+{
+    int i, n, k, j;
+    for (i = 0; i < 64; i++)// centers and padding stay in place
+        perm->perm[i] = i;
+    for (i = 0; i < CORNER_COUNT; i++)
+        for (n = 0; n < 3; n++)
+            perm->perm[cornerFacelet[i][(n + cubiecube->co[i]) % 3]] = cornerFacelet[cubiecube->cp[i]][n];
+    for (i = 0; i < EDGE_COUNT; i++)
+        for (n = 0; n < 2; n++)
+            perm->perm[edgeFacelet[i][(n + cubiecube->eo[i]) % 2]] = edgeFacelet[cubiecube->ep[i]][n];
+    for (k = 0; k < 4; k++)
+        for (j = 0; j < 4; j++)
+            for (i = 0; i < 16; i++) {
+                int src = perm->perm[16 * k + i];
+                perm->shuffle[k][j][i] = src / 16 == j ? src % 16 : 0x80;
+            }
+}
+
+typedef struct {
+    faceletperm_t move[N_MOVE];
+} faceletmoves_t;
+
+const faceletperm_t* faceletMoves(void)
+{
+    static const faceletmoves_t* table = [] {
+        faceletmoves_t* t = new faceletmoves_t();
+        const cubiecube_t* moveCube = moveCubies();
+        for (int mv = 0; mv < N_MOVE; mv++) {
+            cubiecube_t cc = moveCube[mv];
+            faceletPermFromCubie(&cc, &t->move[mv]);
+        }
+        return t;
+    }();
+    return table->move;
+}
+
+void faceletSolved(faceletcube_t* facelets)
+{
+    static const char colors[] = "URFDLB";
+    int i;
+    for (i = 0; i < 54; i++)
+        facelets->f[i] = colors[i / 9];
+    memset(facelets->f + 54, 0, 10);
+}
+
+typedef void (*facelet_fn)(faceletcube_t*, const faceletperm_t*);
+
+static void faceletApplyScalar(faceletcube_t* facelets, const faceletperm_t* p)
+{
+    char old[54];
+    const unsigned char* perm = p->perm;
+    int i;
+    memcpy(old, facelets->f, 54);
+    for (i = 0; i < 54; i++)
+        facelets->f[i] = old[perm[i]];
+}
+
+#if defined(FACELETS_X86)
+
+static int cpuHasSSSE3(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+// Every destination block is the OR of its bytes picked out of the four source blocks
+TARGET_SSSE3 static void faceletApplySSSE3(faceletcube_t* facelets, const faceletperm_t* perm)
+{
+    __m128i* state = (__m128i*) facelets->f;
+    const __m128i* shuffle = (const __m128i*) perm->shuffle;
+    __m128i s0 = _mm_load_si128(state);
+    __m128i s1 = _mm_load_si128(state + 1);
+    __m128i s2 = _mm_load_si128(state + 2);
+    __m128i s3 = _mm_load_si128(state + 3);
+    int k;
+    for (k = 0; k < 4; k++) {
+        __m128i r = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(s0, _mm_load_si128(shuffle + 4 * k)),
+                        _mm_shuffle_epi8(s1, _mm_load_si128(shuffle + 4 * k + 1))),
+                _mm_or_si128(_mm_shuffle_epi8(s2, _mm_load_si128(shuffle + 4 * k + 2)),
+                        _mm_shuffle_epi8(s3, _mm_load_si128(shuffle + 4 * k + 3))));
+        _mm_store_si128(state + k, r);
+    }
+}
+
+#endif
+
+static facelet_fn bestKernel(void)
+{
+#if defined(FACELETS_X86)
+    if (cpuHasSSSE3())
+        return faceletApplySSSE3;
+#endif
+    return faceletApplyScalar;
+}
+
+static std::atomic<facelet_fn> kernel(bestKernel());
+
+int selectFaceletKernel(int allowSimd)
+{
+    facelet_fn selected = allowSimd ? bestKernel() : faceletApplyScalar;
+    kernel.store(selected, std::memory_order_relaxed);
+    return selected != faceletApplyScalar;
+}
+
+void faceletApply(faceletcube_t* facelets, int mv)
+{
+    kernel.load(std::memory_order_relaxed)(facelets, &faceletMoves()[mv]);
+}
+
+void faceletApplyMoves(faceletcube_t* facelets, const unsigned char* moves, int n)
+{
+    const faceletperm_t* move = faceletMoves();
+    facelet_fn apply = kernel.load(std::memory_order_relaxed);
+    int i;
+    for (i = 0; i < n; i++)
+        apply(facelets, &move[moves[i]]);
+}
+
+void faceletApplyPerm(faceletcube_t* facelets, const faceletperm_t* perm)
+{
+    kernel.load(std::memory_order_relaxed)(facelets, perm);
+}
@@ -0,0 +1,39 @@
+#ifndef FACELETMOVES_H
+#define FACELETMOVES_H
+
+#include "coordcube.h"
+
+// Cube on the facelet level as the 54 characters of the cube definition string (see facelet.h), padded to 64
+// bytes so that a move is four 16-byte shuffles.
+typedef struct {
+    alignas(16) char f[64];
+} faceletcube_t;
+
+// Permutation of the facelets. perm[i] is the facelet whose colour moves to facelet i. shuffle[k][j] selects the
+// bytes of source block j that go to destination block k, the other bytes are 0x80 so that pshufb writes a zero.
+typedef struct {
+    alignas(16) unsigned char shuffle[4][4][16];
+    unsigned char perm[64];
+} faceletperm_t;
+
+// The permutations of the moves mv = 3 * axis + power - 1, faceletMoves()[mv], derived from the cubie level moves
+// of sequence.h. Built on the first call, which is thread-safe.
+const faceletperm_t* faceletMoves(void);
+
+// The facelet permutation of a cube on the cubie level
+void faceletPermFromCubie(cubiecube_t* cubiecube, faceletperm_t* perm);
+
+// The solved cube "UUUUUUUUURRRRRRRRRFFFFFFFFFDDDDDDDDDLLLLLLLLLBBBBBBBBB"
+void faceletSolved(faceletcube_t* facelets);
+
+// Apply one move, n moves given by their move codes, or any permutation
+void faceletApply(faceletcube_t* facelets, int mv);
+void faceletApplyMoves(faceletcube_t* facelets, const unsigned char* moves, int n);
+void faceletApplyPerm(faceletcube_t* facelets, const faceletperm_t* perm);
+
+// Select the kernel used by faceletApply. With allowSimd = 0 the scalar loop is always used, otherwise the SSSE3
+// shuffle is used if available. Returns 1 if the SSSE3 kernel is active afterwards. Both kernels give the same
+// results, so this may run while other threads apply moves.
+int selectFaceletKernel(int allowSimd);
+
+#endif
@@ -0,0 +1,60 @@
+#include "incremental.h"
+#include "nearsolved.h"
+#include "optimize.h"
+#include "sequence.h"
+
+void initLastSolve(lastsolve_t* last)
+{
+    compileSequence(NULL, 0, &last->start);
+    last->solution.clear();
+    last->searchLength = 0;
+    last->valid = 0;
+}
+
+void recordLastSolve(lastsolve_t* last, cubiecube_t* cubiecube, const std::vector<uint8_t>& solution, int fullSearch)
+{
+    last->start = *cubiecube;
+    last->solution = solution;
+    if (fullSearch || !last->valid)
+        last->searchLength = (int) solution.size();
+    last->valid = 1;
+}
+
+int incrementalSolve(const lastsolve_t* last, cubiecube_t* cubiecube, int maxDelta, int maxLength,
+        std::vector<uint8_t>& moves)
+{
+    std::vector<uint8_t> candidate;
+    cubiecube_t path, delta;
+    int deltaMoves[32];
+    int n = (int) last->solution.size();
+    int i, j, d, best;
+
+    if (!last->valid || verify(cubiecube) != 0)
+        return 0;
+    if (maxLength > last->searchLength + INCREMENTAL_SLACK)
+        maxLength = last->searchLength + INCREMENTAL_SLACK;
+    best = maxLength + 1;
+    ensureNearSolved();
+
+    path = last->start;
+    for (i = 0; i <= n; i++) {
+        // path = P_i, delta = inverse(P_i) * cube, so the cube is P_i * delta
+        invCubieCube(&path, &delta);
+        multiply(&delta, cubiecube);
+        d = nearSolvedSolve(&delta, deltaMoves);
+        if (d >= 0 && d <= maxDelta && n - i - d < best) {// the optimizer saves at most 2 * d moves
+            candidate.clear();
+            for (j = 0; j < d; j++)
+                candidate.push_back((uint8_t) deltaMoves[j]);
+            candidate.insert(candidate.end(), last->solution.begin() + i, last->solution.end());
+            candidate.resize(optimizeMoves(candidate.data(), (int) candidate.size()));
+            if ((int) candidate.size() < best && solvesCube(cubiecube, candidate.data(), (int) candidate.size())) {
+                best = (int) candidate.size();
+                moves = candidate;
+            }
+        }
+        if (i < n)
+            appendMove(&path, last->solution[i]);
+    }
+    return best <= maxLength;
+}
@@ -0,0 +1,39 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdint.h>
+#include <vector>
+#include "cubiecube.h"
+
+// Re-solve of a cube which was changed by a few moves since its last solve.
+// The last solved cube and its solution are kept. The cubes on the way of that solution are P_0 (the cube of the
+// last solve) .. P_n (the solved cube). If the new cube is P_i * d for a short maneuver d, inverse(d) followed by
+// the rest of the solution from P_i solves it. inverse(d) is found in the near solved table (nearsolved.h), the
+// combined maneuver is post-optimized (optimize.h) and the shortest one over all P_i is taken.
+
+#define INCREMENTAL_MAX_DELTA 4     // default of the longest maneuver d which is looked for
+#define INCREMENTAL_SLACK 2         // moves a re-solve may be longer than the last solution before a full search wins
+
+typedef struct {
+    cubiecube_t start;              // cube of the last solve
+    std::vector<uint8_t> solution;  // its solution as move codes
+    int searchLength;               // length of the last solution which came from a full search
+    int valid;                      // 0 until the first solve is recorded
+} lastsolve_t;
+
+void initLastSolve(lastsolve_t* last);
+
+// Record a solve, later cubes are re-solved relative to it. fullSearch is 1 if the solution came from a full search
+// and 0 if it came from incrementalSolve.
+void recordLastSolve(lastsolve_t* last, cubiecube_t* cubiecube, const std::vector<uint8_t>& solution, int fullSearch);
+
+// Solution of the cube built from the last solve if the cube is at most maxDelta moves away from a cube on its
+// way and the result has at most maxLength moves. A full search of a cube a few moves away from the last one gives
+// about as many moves as the last full search, so a result longer than that by more than INCREMENTAL_SLACK moves
+// is clearly worse and rejected as well. The reference stays the full search, so a chain of re-solves does not
+// creep up by the slack each time. The near solved table is built first if it does not exist yet.
+// Returns 1 and fills moves on success, 0 if a full search is needed.
+int incrementalSolve(const lastsolve_t* last, cubiecube_t* cubiecube, int maxDelta, int maxLength,
+        std::vector<uint8_t>& moves);
+
+#endif
@@ -0,0 +1,168 @@
+#include <stdlib.h>
+#include <mutex>
+#include <vector>
+#include "nearsolved.h"
+#include "coordcube.h"
+#include "sequence.h"
+
+// One table entry, the distance + 1 is stored in the top byte of corners. 0 marks an empty entry.
+typedef struct {
+    uint64_t corners;
+    uint64_t edges;
+} nearentry_t;
+
+int NEAR_SOLVED_INITED = 0;
+
+static nearentry_t* table = NULL;
+static uint64_t tableMask = 0;
+static int tableExtra = 0;
+
+static inline uint64_t nearHash(cubiekey_t* key)
+{
+    uint64_t h = key->corners * 0x9E3779B97F4A7C15ULL ^ key->edges * 0xC2B2AE3D27D4EB4FULL;
+    return (h ^ (h >> 29)) & tableMask;
+}
+
+// Insert a position, returns 1 if it was not yet in the table
+static int nearInsert(cubiekey_t* key, int dist)
+{
+    uint64_t i = nearHash(key);
+    while (table[i].corners != 0) {
+        if ((table[i].corners & 0x00ffffffffffffffULL) == key->corners && table[i].edges == key->edges)
+            return 0;
+        i = (i + 1) & tableMask;
+    }
+    table[i].corners = key->corners | (uint64_t) (dist + 1) << 56;
+    table[i].edges = key->edges;
+    return 1;
+}
+
+long initNearSolved(int maxDist, int extraDepth)
+{
+    static const long positions[7] = { 1, 19, 262, 3502, 46741, 621649, 8240087 };
+    std::vector<cubiecube_t> frontier, next;
+    cubiecube_t* solved;
+    cubiekey_t key;
+    uint64_t size = 1;
+    long count = 1;
+    int d, j;
+
+    free(table);
+    table = NULL;
+    tableMask = 0;
+    tableExtra = extraDepth > 0 ? extraDepth : 0;
+    NEAR_SOLVED_INITED = 1;
+    if (maxDist <= 0)
+        return 0;
+    if (maxDist > 6)
+        maxDist = 6;
+
+    while (size < 2 * (uint64_t) positions[maxDist])// keep the load factor below 1/2
+        size *= 2;
+    table = (nearentry_t*) calloc(size, sizeof(nearentry_t));
+    if (table == NULL)
+        return -1;
+    tableMask = size - 1;
+
+    solved = get_cubiecube();
+    getCubieKey(solved, &key);
+    nearInsert(&key, 0);
+    frontier.push_back(*solved);
+    free(solved);
+
+    // breadth first search, the positions of the last level are not expanded
+    for (d = 1; d <= maxDist; d++) {
+        next.clear();
+        for (const cubiecube_t& c : frontier) {
+            for (j = 0; j < N_MOVE; j++) {
+                cubiecube_t child = c;
+                appendMove(&child, j);
+                getCubieKey(&child, &key);
+                if (nearInsert(&key, d)) {
+                    count++;
+                    if (d < maxDist)
+                        next.push_back(child);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return count;
+}
+
+void ensureNearSolved(void)
+{
+    static std::once_flag defaultTable;
+    std::call_once(defaultTable, [] {
+        if (NEAR_SOLVED_INITED == 0)
+            initNearSolved(NEAR_SOLVED_DEPTH, NEAR_SOLVED_EXTRA);
+    });
+}
+
+int nearSolvedDistance(cubiecube_t* cubiecube)
+{
+    cubiekey_t key;
+    uint64_t i;
+    if (table == NULL)
+        return -1;
+    getCubieKey(cubiecube, &key);
+    i = nearHash(&key);
+    while (table[i].corners != 0) {
+        if ((table[i].corners & 0x00ffffffffffffffULL) == key.corners && table[i].edges == key.edges)
+            return (int) (table[i].corners >> 56) - 1;
+        i = (i + 1) & tableMask;
+    }
+    return -1;
+}
+
+// Follow the distances down to the solved cube
+static int nearDescend(cubiecube_t cc, int dist, int* moves)
+{
+    int n, mv;
+    for (n = 0; n < dist; n++) {
+        for (mv = 0; mv < N_MOVE; mv++) {
+            cubiecube_t child = cc;
+            appendMove(&child, mv);
+            if (nearSolvedDistance(&child) == dist - n - 1) {
+                moves[n] = mv;
+                cc = child;
+                break;
+            }
+        }
+    }
+    return dist;
+}
+
+// Depth first search of exactly depth moves in front of the table. Returns the total length or -1.
+static int nearSearch(cubiecube_t* cc, int depth, int lastAxis, int* moves)
+{
+    int mv, d;
+    if (depth == 0) {
+        if ((d = nearSolvedDistance(cc)) < 0)
+            return -1;
+        return nearDescend(*cc, d, moves);
+    }
+    for (mv = 0; mv < N_MOVE; mv++) {
+        cubiecube_t child = *cc;
+        if (mv / 3 == lastAxis || mv / 3 == lastAxis - 3)
+            continue;
+        appendMove(&child, mv);
+        if ((d = nearSearch(&child, depth - 1, mv / 3, moves + 1)) >= 0) {
+            moves[0] = mv;
+            return d + 1;
+        }
+    }
+    return -1;
+}
+
+int nearSolvedSolve(cubiecube_t* cubiecube, int* moves)
+{
+    int depth, d;
+    if (table == NULL)
+        return -1;
+    // a hit at search depth k means that the cube is exactly k + maxDist moves away, so the first hit is optimal
+    for (depth = 0; depth <= tableExtra; depth++)
+        if ((d = nearSearch(cubiecube, depth, -1, moves)) >= 0)
+            return d;
+    return -1;
+}
@@ -0,0 +1,37 @@
+#ifndef NEARSOLVED_H
+#define NEARSOLVED_H
+
+#include "cubiecube.h"
+
+// Exact distance table for all cubes within a few moves of the solved cube.
+// The positions are stored in a hash table keyed by their cubiekey_t. Cubes in the table are solved optimally by
+// descending the distances, cubes up to extraDepth moves further away by a short search whose leaves are looked
+// up in the table. solution() uses this before the two-phase search, so the first solve of a process pays for
+// building the default table: 32 MB and about 0.25 s for a radius of 5.
+//
+// Number of positions (face turn metric): 1, 18, 243, 3240, 43239, 574908, 7618438 at distance 0..6.
+// The table needs 32 MB for a radius of 5 and 256 MB for 6.
+
+#define NEAR_SOLVED_DEPTH 5 // default radius of the table
+#define NEAR_SOLVED_EXTRA 2 // default search depth in front of the table
+
+extern int NEAR_SOLVED_INITED;
+
+// Build the table for all positions within maxDist moves (at most 6) of the solved cube and solve cubes up to
+// maxDist + extraDepth moves with it. maxDist = 0 disables the table.
+// Returns the number of positions in the table or -1 if the memory could not be allocated. This replaces the table,
+// so it must not run while other threads solve; call it at startup to choose another radius.
+long initNearSolved(int maxDist, int extraDepth);
+
+// Build the default table (NEAR_SOLVED_DEPTH, NEAR_SOLVED_EXTRA) unless initNearSolved ran before. Thread-safe,
+// concurrent first callers wait for one build.
+void ensureNearSolved(void);
+
+// Distance of the cube to the solved cube, -1 if it is not in the table
+int nearSolvedDistance(cubiecube_t* cubiecube);
+
+// Optimal maneuver for a cube within maxDist + extraDepth moves. The moves are written as 3 * axis + power - 1.
+// Returns the length of the maneuver or -1 if the cube is further away.
+int nearSolvedSolve(cubiecube_t* cubiecube, int* moves);
+
+#endif
@@ -0,0 +1,107 @@
+#include "notation.h"
+
+static const char* const names[18] = {
+    "U", "U2", "U'", "R", "R2", "R'", "F", "F2", "F'",
+    "D", "D2", "D'", "L", "L2", "L'", "B", "B2", "B'"
+};
+
+// Axis of a face letter, -1 for all other characters
+struct AxisTable {
+    signed char axis[256];
+    constexpr AxisTable() : axis()
+    {
+        for (int i = 0; i < 256; i++)
+            axis[i] = -1;
+        axis['U'] = 0;
+        axis['R'] = 1;
+        axis['F'] = 2;
+        axis['D'] = 3;
+        axis['L'] = 4;
+        axis['B'] = 5;
+    }
+};
+static constexpr AxisTable axisTable;
+
+static inline int isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+int parseMove(std::string_view token)
+{
+    int axis;
+    if (token.empty() || (axis = axisTable.axis[(unsigned char) token[0]]) < 0)
+        return -1;
+    if (token.size() == 1)
+        return 3 * axis;
+    if (token.size() == 2 && token[1] == '2')
+        return 3 * axis + 1;
+    if (token.size() == 2 && token[1] == '\'')
+        return 3 * axis + 2;
+    if (token.size() == 3 && token[1] == '2' && token[2] == '\'')// a half turn in either direction
+        return 3 * axis + 1;
+    return -1;
+}
+
+// Call f for every token of the text, stop and return 0 if f does
+template <class F>
+static int forEachToken(std::string_view text, F f)
+{
+    size_t i = 0, n = text.size();
+    while (i < n) {
+        size_t start;
+        while (i < n && isSpace(text[i]))
+            i++;
+        if (i == n)
+            break;
+        start = i;
+        while (i < n && !isSpace(text[i]))
+            i++;
+        if (text.substr(start, i - start) == ".")// phase separator
+            continue;
+        if (!f(parseMove(text.substr(start, i - start))))
+            return 0;
+    }
+    return 1;
+}
+
+int parseMoves(std::string_view text, uint8_t* moves, int capacity)
+{
+    int n = 0;
+    int ok = forEachToken(text, [&](int mv) {
+        if (mv < 0 || n == capacity)
+            return 0;
+        moves[n++] = (uint8_t) mv;
+        return 1;
+    });
+    return ok ? n : -1;
+}
+
+int parseMoves(std::string_view text, std::vector<uint8_t>& moves)
+{
+    return forEachToken(text, [&](int mv) {
+        if (mv < 0)
+            return 0;
+        moves.push_back((uint8_t) mv);
+        return 1;
+    });
+}
+
+const char* moveName(int mv)
+{
+    return mv >= 0 && mv < 18 ? names[mv] : "?";
+}
+
+int formatMoves(const uint8_t* moves, int n, char* out)
+{
+    int i, len = 0;
+    for (i = 0; i < n; i++) {
+        const char* name = moveName(moves[i]);
+        if (i > 0)
+            out[len++] = ' ';
+        while (*name)
+            out[len++] = *name++;
+    }
+    out[len] = 0;
+    return len;
+}
@@ -0,0 +1,37 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+
+// Move notation. A move is stored as one byte, the move code 3 * axis + power - 1 with the axes U, R, F, D, L, B
+// and the powers 1 (clockwise), 2 and 3 (counterclockwise), like everywhere in the solver. Parsing works on
+// string_views through a lookup table, formatting writes into a caller supplied buffer, neither allocates.
+enum {
+    MOVE_U, MOVE_U2, MOVE_U_PRIME,
+    MOVE_R, MOVE_R2, MOVE_R_PRIME,
+    MOVE_F, MOVE_F2, MOVE_F_PRIME,
+    MOVE_D, MOVE_D2, MOVE_D_PRIME,
+    MOVE_L, MOVE_L2, MOVE_L_PRIME,
+    MOVE_B, MOVE_B2, MOVE_B_PRIME
+};
+
+// Move code of one move like "R", "R2", "R'" (or "R2'"), -1 if the token is not a move
+int parseMove(std::string_view token);
+
+// Parse moves separated by white space. The "." separating the phases in the solver output is skipped.
+// Returns the number of moves written to moves, or -1 if a token is not a move or there are more than capacity.
+int parseMoves(std::string_view text, uint8_t* moves, int capacity);
+
+// Same as above, the moves are appended to moves. Returns 0 if a token is not a move.
+int parseMoves(std::string_view text, std::vector<uint8_t>& moves);
+
+// Name of a move code, e.g. "R'"
+const char* moveName(int mv);
+
+// Write the moves separated by single spaces and a terminating 0 to out, which needs room for 3 * n + 1
+// characters. Returns the length of the text.
+int formatMoves(const uint8_t* moves, int n, char* out);
+
+#endif
@@ -0,0 +1,61 @@
+#include "optimize.h"
+#include "sequence.h"
+
+int optimizeMoves(uint8_t* moves, int n)
+{
+    int i, j, top = 0;// moves[0..top) is the optimized prefix
+    for (i = 0; i < n; i++) {
+        int ax = moves[i] / 3;
+        int po = moves[i] % 3 + 1;
+        int k = -1;// earlier move of the same face this move merges with
+        if (top > 0 && moves[top - 1] / 3 == ax)
+            k = top - 1;
+        else if (top > 1 && moves[top - 1] / 3 == (ax + 3) % 6 && moves[top - 2] / 3 == ax)
+            k = top - 2;
+        if (k >= 0) {
+            po = (moves[k] % 3 + 1 + po) % 4;
+            if (po == 0) {// the moves cancel
+                for (j = k; j < top - 1; j++)
+                    moves[j] = moves[j + 1];
+                top--;
+            } else
+                moves[k] = (uint8_t) (3 * ax + po - 1);
+        } else if (top > 0 && moves[top - 1] / 3 == ax + 3) {// U before D, R before L, F before B
+            moves[top] = moves[top - 1];
+            moves[top - 1] = (uint8_t) (3 * ax + po - 1);
+            top++;
+        } else
+            moves[top++] = (uint8_t) (3 * ax + po - 1);
+    }
+    return top;
+}
+
+movecount_t countMoves(const uint8_t* moves, int n)
+{
+    movecount_t count = { n, 0, 0 };
+    int i;
+    for (i = 0; i < n; i++)
+        count.qtm += moves[i] % 3 == 1 ? 2 : 1;
+    for (i = 0; i < n; i++) {
+        count.stm++;
+        if (i + 1 < n && (moves[i] / 3 + 3) % 6 == moves[i + 1] / 3 && moves[i] % 3 + moves[i + 1] % 3 == 2)
+            i++;// both faces turn like the slice between them
+    }
+    return count;
+}
+
+int solvesCube(cubiecube_t* cc, const uint8_t* moves, int n)
+{
+    cubiecube_t c = *cc;
+    cubiecube_t compiled;
+    int i;
+    compileSequence(moves, n, &compiled);
+    multiply(&c, &compiled);
+    for (i = 0; i < 8; i++)
+        if (c.cp[i] != i || c.co[i] != 0)
+            return 0;
+    for (i = 0; i < 12; i++)
+        if (c.ep[i] != i || c.eo[i] != 0)
+            return 0;
+    return 1;
+}
@@ -0,0 +1,29 @@
+#ifndef OPTIMIZE_H
+#define OPTIMIZE_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// Post processing of maneuvers given as move codes (see notation.h). Moves of the same face are merged or cancel,
+// and so do moves of the same face which are only separated by a move of the opposite face (U D U' = D).
+// Commuting opposite face moves are brought into the order U before D, R before L and F before B, so equal
+// maneuvers have equal move lists.
+
+// lengths of a maneuver in the half turn, quarter turn and slice turn metric
+typedef struct {
+    int htm;
+    int qtm;
+    int stm;    // opposite face moves turning the same way (U D', R2 L2 ...) count as one slice turn
+} movecount_t;
+
+// Optimize the n moves in place and return the new number of moves. The maneuver is the same permutation
+// afterwards and never gets longer in any metric. O(n).
+int optimizeMoves(uint8_t* moves, int n);
+
+// Lengths of the n moves in all three metrics
+movecount_t countMoves(const uint8_t* moves, int n);
+
+// 1 if the n moves applied to cc result in the solved cube, else 0
+int solvesCube(cubiecube_t* cc, const uint8_t* moves, int n);
+
+#endif
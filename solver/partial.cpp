@@ -0,0 +1,371 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "partial.h"
+#include "coordcube.h"
+#include "sequence.h"
+#include "prunetable_helpers.h"
+
+enum { COORD_CORNERS, COORD_EDGES, COORD_TWIST, COORD_FLIP };
+
+typedef struct {
+    int type;
+    unsigned mask;          // tracked pieces of a COORD_CORNERS or COORD_EDGES coordinate
+    int pieces[PARTIAL_MAX_PIECES];
+    int k;
+    int size;
+    int solved;             // coordinate of the solved cube
+    int* move;              // move[N_MOVE * coord + mv]
+} partialcoord_t;
+
+// Pruning table of the product of some coordinates, two distances per byte like the other pruning tables
+typedef struct {
+    int coord[PARTIAL_MAX_COORDS];
+    int count;
+    long size;
+    signed char* table;
+} partialprune_t;
+
+struct partialsolver {
+    int ncoord;
+    partialcoord_t coord[PARTIAL_MAX_COORDS];
+    int nprune;
+    partialprune_t prune[PARTIAL_MAX_COORDS * (PARTIAL_MAX_COORDS + 1) / 2];
+};
+
+// ++++++++++++++++++++++++++++++++++++ coordinates ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+static int subsetCount(const partialcoord_t* pc)
+{
+    return pc->type == COORD_CORNERS ? CORNER_COUNT : EDGE_COUNT;
+}
+
+static int subsetOrientations(const partialcoord_t* pc)
+{
+    return pc->type == COORD_CORNERS ? 3 : 2;
+}
+
+// positions of the tracked pieces as a k-permutation of the n positions, times their orientations
+static int encode(const partialcoord_t* pc, cubiecube_t* cc)
+{
+    int n, o, i, pos, idx = 0, ori = 0;
+    unsigned used = 0;
+    if (pc->type == COORD_TWIST)
+        return getTwist(cc);
+    if (pc->type == COORD_FLIP)
+        return getFlip(cc);
+    n = subsetCount(pc);
+    o = subsetOrientations(pc);
+    for (i = 0; i < pc->k; i++) {
+        int lower = 0, j;
+        for (pos = 0; pos < n; pos++)
+            if ((pc->type == COORD_CORNERS ? (int) cc->cp[pos] : (int) cc->ep[pos]) == pc->pieces[i])
+                break;
+        for (j = 0; j < pos; j++)
+            lower += (used >> j) & 1;
+        idx = idx * (n - i) + pos - lower;
+        ori = ori * o + (pc->type == COORD_CORNERS ? cc->co[pos] : cc->eo[pos]);
+        used |= 1u << pos;
+    }
+    for (i = 0; i < pc->k; i++)
+        idx *= o;
+    return idx + ori;
+}
+
+// A cube with the given coordinate. The pieces which are not tracked fill the free positions in order.
+static void decode(const partialcoord_t* pc, int coord, cubiecube_t* cc)
+{
+    int n, o, i, pos, rank[PARTIAL_MAX_PIECES], orient[PARTIAL_MAX_PIECES];
+    unsigned used = 0, placed = 0;
+    compileSequence(NULL, 0, cc);
+    if (pc->type == COORD_TWIST) {
+        setTwist(cc, (short) coord);
+        return;
+    }
+    if (pc->type == COORD_FLIP) {
+        setFlip(cc, (short) coord);
+        return;
+    }
+    n = subsetCount(pc);
+    o = subsetOrientations(pc);
+    for (i = pc->k - 1; i >= 0; i--) {
+        orient[i] = coord % o;
+        coord /= o;
+    }
+    for (i = pc->k - 1; i >= 0; i--) {
+        rank[i] = coord % (n - i);
+        coord /= n - i;
+    }
+    for (i = 0; i < pc->k; i++) {
+        int r = rank[i];
+        for (pos = 0; pos < n; pos++)
+            if (!((used >> pos) & 1) && r-- == 0)
+                break;
+        if (pc->type == COORD_CORNERS) {
+            cc->cp[pos] = (corner_t) pc->pieces[i];
+            cc->co[pos] = (signed char) orient[i];
+        } else {
+            cc->ep[pos] = (edge_t) pc->pieces[i];
+            cc->eo[pos] = (signed char) orient[i];
+        }
+        used |= 1u << pos;
+        placed |= 1u << pc->pieces[i];
+    }
+    for (pos = 0, i = 0; pos < n; pos++) {
+        if ((used >> pos) & 1)
+            continue;
+        while ((placed >> i) & 1)
+            i++;
+        if (pc->type == COORD_CORNERS)
+            cc->cp[pos] = (corner_t) i;
+        else
+            cc->ep[pos] = (edge_t) i;
+        i++;
+    }
+}
+
+// ++++++++++++++++++++++++++++++++++++ tables +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+static int initCoordMoves(partialcoord_t* pc, const char* cache_dir)
+{
+    char name[32];
+    int coord, mv;
+    cubiecube_t cc;
+    pc->move = (int*) malloc(sizeof(int) * N_MOVE * pc->size);
+    if (pc->move == NULL)
+        return -1;
+    snprintf(name, sizeof(name), "partial_mv_%d_%x", pc->type, pc->mask);
+    if (cache_dir == NULL || check_cached_table(name, pc->move, sizeof(int) * N_MOVE * pc->size, cache_dir) != 0) {
+        for (coord = 0; coord < pc->size; coord++)
+            for (mv = 0; mv < N_MOVE; mv++) {
+                decode(pc, coord, &cc);
+                appendMove(&cc, mv);
+                pc->move[N_MOVE * coord + mv] = encode(pc, &cc);
+            }
+        if (cache_dir != NULL)
+            dump_to_file(pc->move, sizeof(int) * N_MOVE * pc->size, name, cache_dir);
+    }
+    return 0;
+}
+
+static long pruneIndex(const partialsolver_t* ps, const partialprune_t* pp, const int* coords)
+{
+    long index = 0;
+    int i;
+    for (i = 0; i < pp->count; i++)
+        index = index * ps->coord[pp->coord[i]].size + coords[pp->coord[i]];
+    return index;
+}
+
+// Breadth first search from the solved cube over the product of the coordinates of the table.
+// Distances above 14 are stored as 15, which is still a lower bound.
+static int initPruneTable(const partialsolver_t* ps, partialprune_t* pp, const char* name, const char* cache_dir)
+{
+    int coords[PARTIAL_MAX_COORDS], next[PARTIAL_MAX_COORDS];
+    long index, done = 1;
+    int depth = 0, i, mv;
+    if ((pp->table = (signed char*) malloc(pp->size / 2 + 1)) == NULL)
+        return -1;
+    if (cache_dir != NULL && check_cached_table(name, pp->table, (int) (pp->size / 2 + 1), cache_dir) == 0)
+        return 0;
+    memset(pp->table, -1, pp->size / 2 + 1);
+    for (i = 0; i < ps->ncoord; i++)
+        coords[i] = ps->coord[i].solved;
+    setPruning(pp->table, (int) pruneIndex(ps, pp, coords), 0);
+    while (done < pp->size && depth < 14) {
+        for (index = 0; index < pp->size; index++) {
+            long rest = index;
+            if (getPruning(pp->table, (int) index) != depth)
+                continue;
+            for (i = pp->count - 1; i >= 0; i--) {
+                coords[pp->coord[i]] = (int) (rest % ps->coord[pp->coord[i]].size);
+                rest /= ps->coord[pp->coord[i]].size;
+            }
+            for (mv = 0; mv < N_MOVE; mv++) {
+                long n;
+                for (i = 0; i < pp->count; i++)
+                    next[pp->coord[i]] = ps->coord[pp->coord[i]].move[N_MOVE * coords[pp->coord[i]] + mv];
+                n = pruneIndex(ps, pp, next);
+                if (getPruning(pp->table, (int) n) == 0x0f) {
+                    setPruning(pp->table, (int) n, (signed char) (depth + 1));
+                    done++;
+                }
+            }
+        }
+        depth++;
+    }
+    if (cache_dir != NULL)
+        dump_to_file(pp->table, (int) (pp->size / 2 + 1), name, cache_dir);
+    return 0;
+}
+
+// Add a pruning table over the coordinates of the bit mask if their product is small enough
+static int addPruneTable(partialsolver_t* ps, unsigned coords, const partialgoal_t* goal, const char* cache_dir)
+{
+    partialprune_t* pp = &ps->prune[ps->nprune];
+    char name[32];
+    int i;
+    pp->count = 0;
+    pp->size = 1;
+    for (i = 0; i < ps->ncoord; i++)
+        if ((coords >> i) & 1) {
+            pp->coord[pp->count++] = i;
+            pp->size *= ps->coord[i].size;
+            if (pp->size > PARTIAL_JOINT_LIMIT)
+                return 0;
+        }
+    if (pp->count == 1)// shared by all goals with this coordinate
+        snprintf(name, sizeof(name), "partial_pr_%d_%x", ps->coord[pp->coord[0]].type, ps->coord[pp->coord[0]].mask);
+    else
+        snprintf(name, sizeof(name), "partial_%02x_%03x_%d%d_%02x", goal->corners & 0xff, goal->edges & 0xfff,
+                goal->cornerOrientation != 0, goal->edgeOrientation != 0, coords);
+    if (initPruneTable(ps, pp, name, cache_dir) != 0)
+        return -1;
+    ps->nprune++;
+    return 1;
+}
+
+static void addCoord(partialsolver_t* ps, int type, unsigned mask)
+{
+    partialcoord_t* pc = &ps->coord[ps->ncoord++];
+    int p, o, i;
+    cubiecube_t cc;
+    pc->type = type;
+    pc->mask = mask;
+    pc->k = 0;
+    for (p = 0; p < EDGE_COUNT; p++)
+        if ((mask >> p) & 1)
+            pc->pieces[pc->k++] = p;
+    if (type == COORD_TWIST)
+        pc->size = N_TWIST;
+    else if (type == COORD_FLIP)
+        pc->size = N_FLIP;
+    else {
+        o = subsetOrientations(pc);
+        pc->size = 1;
+        for (i = 0; i < pc->k; i++)
+            pc->size *= (subsetCount(pc) - i) * o;
+    }
+    compileSequence(NULL, 0, &cc);
+    pc->solved = encode(pc, &cc);
+}
+
+// split the pieces of a mask into coordinates of at most PARTIAL_MAX_PIECES pieces
+static void addSubsets(partialsolver_t* ps, int type, unsigned mask)
+{
+    while (mask != 0) {
+        unsigned part = 0;
+        int k = 0, p;
+        for (p = 0; p < EDGE_COUNT && k < PARTIAL_MAX_PIECES; p++)
+            if ((mask >> p) & 1) {
+                part |= 1u << p;
+                k++;
+            }
+        addCoord(ps, type, part);
+        mask &= ~part;
+    }
+}
+
+partialsolver_t* initPartialSolver(const partialgoal_t* goal, const char* cache_dir)
+{
+    partialsolver_t* ps = (partialsolver_t*) calloc(1, sizeof(partialsolver_t));
+    int i, j, added;
+
+    if (ps == NULL)
+        return NULL;
+    addSubsets(ps, COORD_CORNERS, goal->corners & 0xff);
+    addSubsets(ps, COORD_EDGES, goal->edges & 0xfff);
+    if (goal->cornerOrientation)
+        addCoord(ps, COORD_TWIST, 0);
+    if (goal->edgeOrientation)
+        addCoord(ps, COORD_FLIP, 0);
+    if (ps->ncoord == 0) {
+        free(ps);
+        return NULL;
+    }
+    for (i = 0; i < ps->ncoord; i++)
+        if (initCoordMoves(&ps->coord[i], cache_dir) != 0) {
+            freePartialSolver(ps);
+            return NULL;
+        }
+    // one table for all coordinates if it is small enough, else one for each pair which is small enough and one
+    // for each coordinate
+    if ((added = addPruneTable(ps, (1u << ps->ncoord) - 1, goal, cache_dir)) == 0) {
+        for (i = 0; i < ps->ncoord && added >= 0; i++)
+            for (j = i + 1; j < ps->ncoord && added >= 0; j++)
+                added = addPruneTable(ps, (1u << i) | (1u << j), goal, cache_dir);
+        for (i = 0; i < ps->ncoord && added >= 0; i++)
+            added = addPruneTable(ps, 1u << i, goal, cache_dir);
+    }
+    if (added < 0) {
+        freePartialSolver(ps);
+        return NULL;
+    }
+    return ps;
+}
+
+void freePartialSolver(partialsolver_t* ps)
+{
+    int i;
+    if (ps == NULL)
+        return;
+    for (i = 0; i < ps->ncoord; i++)
+        free(ps->coord[i].move);
+    for (i = 0; i < ps->nprune; i++)
+        free(ps->prune[i].table);
+    free(ps);
+}
+
+// ++++++++++++++++++++++++++++++++++++ search +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+static int bound(const partialsolver_t* ps, const int* coords)
+{
+    int i, d, dist = 0;
+    for (i = 0; i < ps->nprune; i++)
+        if ((d = getPruning(ps->prune[i].table, (int) pruneIndex(ps, &ps->prune[i], coords))) > dist)
+            dist = d;
+    return dist;
+}
+
+// depth first search of all maneuvers with togo more moves, moves[0..n) is the maneuver so far
+static int search(const partialsolver_t* ps, const int* coords, int n, int togo, uint8_t* moves)
+{
+    int mv, i, next[PARTIAL_MAX_COORDS];
+    int dist = bound(ps, coords);
+    if (dist == 0)
+        return n;
+    if (dist > togo)
+        return -1;
+    for (mv = 0; mv < N_MOVE; mv++) {
+        int ax = mv / 3, found;
+        if (n != 0 && (moves[n - 1] / 3 == ax || moves[n - 1] / 3 - 3 == ax))
+            continue;
+        for (i = 0; i < ps->ncoord; i++)
+            next[i] = ps->coord[i].move[N_MOVE * coords[i] + mv];
+        moves[n] = (uint8_t) mv;
+        if ((found = search(ps, next, n + 1, togo - 1, moves)) >= 0)
+            return found;
+    }
+    return -1;
+}
+
+int partialDistanceBound(const partialsolver_t* ps, cubiecube_t* cc)
+{
+    int i, coords[PARTIAL_MAX_COORDS];
+    for (i = 0; i < ps->ncoord; i++)
+        coords[i] = encode(&ps->coord[i], cc);
+    return bound(ps, coords);
+}
+
+int partialSolve(const partialsolver_t* ps, cubiecube_t* cc, int maxDepth, uint8_t* moves)
+{
+    int i, depth, found, coords[PARTIAL_MAX_COORDS];
+    for (i = 0; i < ps->ncoord; i++)
+        coords[i] = encode(&ps->coord[i], cc);
+    if (maxDepth > PARTIAL_MAX_DEPTH)
+        maxDepth = PARTIAL_MAX_DEPTH;
+    for (depth = bound(ps, coords); depth <= maxDepth; depth++)
+        if ((found = search(ps, coords, 0, depth, moves)) >= 0)
+            return found;
+    return -1;
+}
@@ -0,0 +1,49 @@
+#ifndef PARTIAL_H
+#define PARTIAL_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// Optimal solver for partial goals like the cross, an F2L pair or the edge orientation.
+// A goal names the pieces which have to be in place (and oriented), and whether all corners or edges have to be
+// oriented wherever they are. The cube is described by a few small coordinates: the positions and orientations of
+// up to PARTIAL_MAX_PIECES tracked pieces of one kind each, and the twist/flip of all corners/edges. Move tables of
+// these coordinates and pruning tables (one for their product if it is small enough, else one per coordinate) are
+// generated when the solver is created and cached in cache_dir through prunetable_helpers. The search is IDA*
+// on the coordinates, so the solutions are optimal in the face turn metric.
+//
+// Examples (piece names from corner.h and edge.h):
+//   cross            edges = PARTIAL_PIECE(DR) | PARTIAL_PIECE(DF) | PARTIAL_PIECE(DL) | PARTIAL_PIECE(DB)
+//   FR pair          corners = PARTIAL_PIECE(DFR), edges = PARTIAL_PIECE(FR)
+//   edge orientation edgeOrientation = 1
+
+#define PARTIAL_PIECE(p) (1u << (p))
+#define PARTIAL_MAX_PIECES 4        // tracked pieces per coordinate, larger sets are split
+#define PARTIAL_MAX_COORDS 8
+#define PARTIAL_JOINT_LIMIT (1 << 26)   // largest product of the coordinates with a joint pruning table
+#define PARTIAL_MAX_DEPTH 20
+
+typedef struct {
+    unsigned corners;       // corners which have to be in place and oriented, PARTIAL_PIECE bits
+    unsigned edges;         // same for the edges
+    int cornerOrientation;  // 1 if all corners have to be oriented
+    int edgeOrientation;    // 1 if all edges have to be oriented
+} partialgoal_t;
+
+typedef struct partialsolver partialsolver_t;
+
+// Generate or load the tables of a goal. Tables are not cached if cache_dir is NULL.
+// Returns NULL if the goal is empty or the memory could not be allocated.
+partialsolver_t* initPartialSolver(const partialgoal_t* goal, const char* cache_dir);
+
+void freePartialSolver(partialsolver_t* solver);
+
+// Optimal maneuver which brings the cube to the goal, written to moves as move codes. The solver is not changed by
+// a search, so any number of threads may search with it at once.
+// Returns the number of moves, or -1 if the goal needs more than maxDepth moves.
+int partialSolve(const partialsolver_t* solver, cubiecube_t* cubiecube, int maxDepth, uint8_t* moves);
+
+// Number of moves the cube needs at least to reach the goal, from the pruning tables
+int partialDistanceBound(const partialsolver_t* solver, cubiecube_t* cubiecube);
+
+#endif
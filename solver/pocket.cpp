@@ -0,0 +1,271 @@
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "pocket.h"
+#include "symmetry.h"
+#include "prunetable_helpers.h"
+
+#define N_POCKET_PERM 5040      // 7!, corner permutations with DRB in place
+#define N_POCKET_TWIST 729      // 3^6, twists of URF..DLF, DBL follows and DRB is 0
+#define N_POCKET_MOVE 9         // U, F and L turns, the moves which leave DRB in place
+#define UNSEEN 3                // table entry of a position the breadth first search did not reach yet
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define PREFETCH(addr) _mm_prefetch((const char*) (addr), _MM_HINT_T0)
+#else
+#define PREFETCH(addr) ((void) 0)
+#endif
+
+int POCKET_INITED = 0;
+
+static uint8_t pocketTable[N_POCKET / 4];
+static unsigned short pocketPermMove[N_POCKET_PERM][N_POCKET_MOVE];
+static unsigned short pocketTwistMove[N_POCKET_TWIST][N_POCKET_MOVE];
+static const uint8_t pocketMoveCode[N_POCKET_MOVE] = { 0, 1, 2, 6, 7, 8, 12, 13, 14 };
+// rotation[p][o] is the symmetry which brings the DRB corner from position p with orientation o to its place
+static int rotation[8][3];
+
+static inline int getPocketDist(int i)
+{
+    return pocketTable[i >> 2] >> ((i & 3) << 1) & 3;
+}
+
+static inline void setPocketDist(int i, int dist)
+{
+    pocketTable[i >> 2] = (uint8_t) ((pocketTable[i >> 2] & ~(3 << ((i & 3) << 1))) | dist << ((i & 3) << 1));
+}
+
+static inline int pocketNext(int i, int k)
+{
+    return pocketPermMove[i / N_POCKET_TWIST][k] * N_POCKET_TWIST + pocketTwistMove[i % N_POCKET_TWIST][k];
+}
+
+static void initPocketMoves(void)
+{
+    static const int axis[3] = { 0, 2, 4 };
+    cubiecube_t* moveCube = get_moveCube();
+    cubiecube_t* a = get_cubiecube();
+    int i, j, k, s;
+
+    for (i = 0; i < N_POCKET_PERM; i++) {
+        setURFtoDLB(a, i);
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                cornerMultiply(a, &moveCube[axis[j]]);
+                pocketPermMove[i][3 * j + k] = (unsigned short) getURFtoDLB(a);
+            }
+            cornerMultiply(a, &moveCube[axis[j]]);// 4. faceturn restores
+        }
+    }
+    for (i = 0; i < N_POCKET_TWIST; i++) {
+        int sum = 0;
+        for (k = i; k > 0; k /= 3)
+            sum += k % 3;
+        setTwist(a, (short) (3 * i + (3 - sum % 3) % 3));// DBL is twisted so that DRB is not
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                cornerMultiply(a, &moveCube[axis[j]]);
+                pocketTwistMove[i][3 * j + k] = (unsigned short) (getTwist(a) / 3);
+            }
+            cornerMultiply(a, &moveCube[axis[j]]);
+        }
+    }
+    free(a);
+
+    for (s = 0; s < N_SYM; s += 2) {// the even symmetries are the rotations
+        cubiecube_t* sym = symmetryCube(s);
+        rotation[sym->cp[DRB]][(3 - sym->co[DRB]) % 3] = s;
+    }
+}
+
+// Call f(begin, end) for a split of all positions into ranges on the given number of threads. The ranges start at
+// multiples of 8, so no two threads write to the same byte of a table with 2 or 1 bits per position.
+template <typename F>
+static void forRanges(int threads, F f)
+{
+    std::vector<std::thread> workers;
+    long step = ((N_POCKET + threads - 1) / threads + 7) & ~7L;
+    for (long begin = step; begin < N_POCKET; begin += step)
+        workers.emplace_back(f, begin, begin + step < N_POCKET ? begin + step : N_POCKET);
+    f(0L, step < N_POCKET ? step : N_POCKET);
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// Breadth first search from the solved cube. Small frontiers are expanded forward on one thread. Large ones are
+// found backward: every thread looks for the unseen positions of its range with a neighbour in the frontier and
+// marks them in a bitmap, which is copied into the table after all threads are done.
+static long buildPocketTable(int threads)
+{
+    std::vector<uint8_t> found(N_POCKET / 8 + 1);
+    long reached = 1, frontier = 1;
+    int depth;
+
+    memset(pocketTable, 0xff, sizeof(pocketTable));
+    setPocketDist(0, 0);
+    for (depth = 0; frontier > 0; depth++) {
+        int cur = depth % 3, next = (depth + 1) % 3;
+        if (frontier < (N_POCKET - reached) / 8) {
+            frontier = 0;
+            for (int i = 0; i < N_POCKET; i++) {
+                if (getPocketDist(i) != cur)// also distances depth - 3, ..., their neighbours are all seen
+                    continue;
+                for (int k = 0; k < N_POCKET_MOVE; k++) {
+                    int j = pocketNext(i, k);
+                    if (getPocketDist(j) == UNSEEN) {
+                        setPocketDist(j, next);
+                        frontier++;
+                    }
+                }
+            }
+        } else {
+            std::atomic<long> count(0);
+            memset(found.data(), 0, found.size());
+            // an unseen position is at least depth + 1 moves away, so a neighbour with cur is at distance depth
+            forRanges(threads, [&](long begin, long end) {
+                long n = 0;
+                for (long i = begin; i < end; i++) {
+                    if (getPocketDist((int) i) != UNSEEN)
+                        continue;
+                    for (int k = 0; k < N_POCKET_MOVE; k++)
+                        if (getPocketDist(pocketNext((int) i, k)) == cur) {
+                            found[i >> 3] |= (uint8_t) (1 << (i & 7));
+                            n++;
+                            break;
+                        }
+                }
+                count += n;
+            });
+            forRanges(threads, [&](long begin, long end) {
+                for (long i = begin; i < end; i++)
+                    if (found[i >> 3] >> (i & 7) & 1)
+                        setPocketDist((int) i, next);
+            });
+            frontier = count;
+        }
+        reached += frontier;
+    }
+    return reached;
+}
+
+long initPocket(const char* cache_dir, int threads)
+{
+    long positions = N_POCKET;
+    if (threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+    initPocketMoves();
+    if (check_cached_table("pocketDistance", (void*) pocketTable, sizeof(pocketTable), cache_dir) != 0) {
+        positions = buildPocketTable(threads);
+        dump_to_file((void*) pocketTable, sizeof(pocketTable), "pocketDistance", cache_dir);
+    }
+    POCKET_INITED = 1;
+    return positions;
+}
+
+// Index of the corners rotated so that DRB is in place, -1 if they are not a valid pocket cube. sym receives the
+// rotation.
+static int pocketIndex(cubiecube_t* cubiecube, int* sym)
+{
+    int seen = 0, twist = 0, p = 0, i;
+    cubiecube_t c;
+    for (i = 0; i < CORNER_COUNT; i++) {
+        if (cubiecube->cp[i] < URF || cubiecube->cp[i] > DRB || cubiecube->co[i] < 0 || cubiecube->co[i] > 2)
+            return -1;
+        seen |= 1 << cubiecube->cp[i];
+        twist += cubiecube->co[i];
+        if (cubiecube->cp[i] == DRB)
+            p = i;
+    }
+    if (seen != 0xff || twist % 3 != 0)
+        return -1;
+    *sym = rotation[p][cubiecube->co[p]];
+    c = *cubiecube;
+    cornerMultiply(&c, symmetryCube(*sym));
+    return getURFtoDLB(&c) * N_POCKET_TWIST + getTwist(&c) / 3;
+}
+
+// Follow the distances down to the solved cube, moves may be NULL. The table entries of all neighbours are
+// requested before the first one is compared, so their cache misses overlap.
+static int descend(int i, uint8_t* moves)
+{
+    int perm = i / N_POCKET_TWIST, twist = i % N_POCKET_TWIST;
+    int dist = getPocketDist(i), n = 0, k;
+    int next[N_POCKET_MOVE];
+    while (perm != 0 || twist != 0) {
+        int want = (dist + 2) % 3;
+        for (k = 0; k < N_POCKET_MOVE; k++) {
+            next[k] = pocketPermMove[perm][k] * N_POCKET_TWIST + pocketTwistMove[twist][k];
+            PREFETCH(&pocketTable[next[k] >> 2]);
+        }
+        for (k = 0; k < N_POCKET_MOVE; k++)
+            if (getPocketDist(next[k]) == want)
+                break;
+        if (k == N_POCKET_MOVE || n == POCKET_MAX_LENGTH)// only with a broken table
+            return -1;
+        if (moves != NULL)
+            moves[n] = pocketMoveCode[k];
+        n++;
+        perm = pocketPermMove[perm][k];
+        twist = pocketTwistMove[twist][k];
+        dist = want;
+    }
+    return n;
+}
+
+int pocketSolve(cubiecube_t* cubiecube, uint8_t* moves)
+{
+    int sym, i, n;
+    if (POCKET_INITED == 0 || (i = pocketIndex(cubiecube, &sym)) < 0)
+        return -1;
+    // M solves C * S, so S * M * S^-1 solves C up to the rotation S^-1
+    if ((n = descend(i, moves)) > 0)
+        conjugateMoves(inverseSymmetry(sym), moves, n);
+    return n;
+}
+
+int pocketDistance(cubiecube_t* cubiecube)
+{
+    int sym, i;
+    if (POCKET_INITED == 0 || (i = pocketIndex(cubiecube, &sym)) < 0)
+        return -1;
+    return descend(i, NULL);
+}
+
+void pocketSolveMany(cubiecube_t* cubes, int count, uint8_t* moves, int* lengths, int threads,
+        const char* cache_dir)
+{
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    int i;
+
+    if (POCKET_INITED == 0)
+        initPocket(cache_dir, threads);
+    if (threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    if (threads > (count + 1023) / 1024)
+        threads = (count + 1023) / 1024;
+    if (threads < 1)
+        threads = 1;
+
+    // blocks of cubes keep the threads off the shared counter
+    auto work = [&]() {
+        int begin;
+        while ((begin = next.fetch_add(1024)) < count) {
+            int end = begin + 1024 < count ? begin + 1024 : count;
+            for (int k = begin; k < end; k++)
+                lengths[k] = pocketSolve(&cubes[k], moves + (size_t) k * POCKET_MAX_LENGTH);
+        }
+    };
+    for (i = 1; i < threads; i++)
+        workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers)
+        worker.join();
+}
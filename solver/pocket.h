@@ -0,0 +1,42 @@
+#ifndef POCKET_H
+#define POCKET_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// Optimal solver of the 2x2x2 (pocket) cube with a complete distance table.
+// A pocket cube is the corner half of a cubiecube_t, the edges are ignored. It has no centers, so the whole cube
+// may be turned in the hand: every cube is first rotated so that the DRB corner is in place and not twisted, then
+// only U, F and L turns are needed (a D turn is a U turn with a rotation of the cube). This leaves 7! * 3^6 =
+// 3,674,160 positions, indexed by getURFtoDLB (< 7! with DRB in place) and getTwist / 3 (the twist of DBL follows
+// from the others). Their distances modulo 3 are stored in 2 bits each, 900 KB in total. Every position has a
+// neighbour whose distance is one less, and only that neighbour has the distance - 1 modulo 3, so the table is
+// descended to the solved cube without knowing the distance in advance.
+//
+// Number of positions (face turn metric): 1, 9, 54, 321, 1847, 9992, 50136, 227536, 870072, 1887748, 623800, 2644
+// at distance 0..11.
+
+#define N_POCKET 3674160
+#define POCKET_MAX_LENGTH 11    // God's number of the pocket cube in the face turn metric
+
+extern int POCKET_INITED;
+
+// Load the distance table from cache_dir or build it with a breadth first search on the given number of threads
+// (0 for one per hardware thread) and cache it there. Returns the number of positions or -1.
+long initPocket(const char* cache_dir, int threads);
+
+// Optimal maneuver for the corners of the cube in moves (room for POCKET_MAX_LENGTH move codes), written as
+// 3 * axis + power - 1 like solution(). The maneuver solves the cube up to a rotation of the whole cube.
+// Returns its length, or -1 if the corners are not a valid pocket cube or the table was not initialized.
+int pocketSolve(cubiecube_t* cubiecube, uint8_t* moves);
+
+// Length of the optimal maneuver, -1 like pocketSolve
+int pocketDistance(cubiecube_t* cubiecube);
+
+// Solve count cubes with the given number of threads (0 for one per hardware thread). The maneuver of cubes[i] is
+// written to moves + i * POCKET_MAX_LENGTH and its length (or -1) to lengths[i]. The table is initialized from
+// cache_dir first if needed.
+void pocketSolveMany(cubiecube_t* cubes, int count, uint8_t* moves, int* lengths, int threads,
+        const char* cache_dir);
+
+#endif
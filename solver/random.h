@@ -6,30 +6,25 @@
 #include<vector> 
 #include <cstdlib> 
 #include <ctime> 
+#include "sequence.h"
+#include "randomstate.h"
+#include "notation.h"
 using namespace std;
 
+// Random number in 1..100 and N_M random move codes without two turns of the same face in a row, both drawn from
+// the generator of the calling thread
 int randomNum();
-std::vector<std::string> scramble(int N_M);
+std::vector<uint8_t> scramble(int N_M);
 
-void cara0(char* R);
-void cara1(char* R);
-void cara2(char* R);
-void cara3(char* R);
-void cara4(char* R);
-void cara5(char* R);
+// Reset a compiled move sequence (see sequence.h) to no moves
+void clear_moves(cubiecube_t* compiled);
 
-void print(char R[6][3][3]);
-void giroU(char R[6][3][3], int c);
-void giroR(char R[6][3][3], int c);
-void giroF(char R[6][3][3], int c);
-void giroD(char R[6][3][3], int c);
-void giroL(char R[6][3][3], int c);
-void giroB(char R[6][3][3], int c);
-void moving(char R[6][3][3], vector<string> moves);
+// Cube definition string of the moves applied to the solved cube, on the facelet level with the permutation
+// tables of faceletmoves.h
+std::string to_cube_not(cubiecube_t* compiled);
+std::string to_cube_not(const std::vector<uint8_t>& moves);
 
-std::string reverse(char R[6][3][3], int f);
-std::string codificar(char R[6][3][3]);
-std::string to_cube_not(std::vector<std::string> moves);
+// Cube definition string of a uniformly distributed random cube
 std::string randomize();
 
 #endif
\ No newline at end of file
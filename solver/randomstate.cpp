@@ -0,0 +1,81 @@
+#include <random>
+#include "randomstate.h"
+#include "coordcube.h"
+#include "facecube.h"
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+void seedRandom(xoshiro_t* rng, uint64_t seed)
+{
+    int i;
+    for (i = 0; i < 4; i++) {// splitmix64, never gives an all zero state
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t nextRandom(xoshiro_t* rng)
+{
+    uint64_t* s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+uint64_t randomBelow(xoshiro_t* rng, uint64_t n)
+{
+    // rejection of the incomplete last block keeps the distribution exactly uniform
+    uint64_t limit = UINT64_MAX - UINT64_MAX % n;
+    uint64_t x;
+    do {
+        x = nextRandom(rng);
+    } while (x >= limit);
+    return x % n;
+}
+
+xoshiro_t* threadRandom(void)
+{
+    static thread_local xoshiro_t rng;
+    static thread_local int seeded = 0;
+    if (!seeded) {
+        std::random_device device;
+        seedRandom(&rng, ((uint64_t) device() << 32) ^ device() ^ (uint64_t) (uintptr_t) &rng);
+        seeded = 1;
+    }
+    return &rng;
+}
+
+void randomCubieCube(xoshiro_t* rng, cubiecube_t* result)
+{
+    static const int N_CORNER_PERM = 40320;// 8!
+    static const int N_EDGE_PERM = 479001600;// 12!
+    edge_t e;
+
+    setURFtoDLB(result, (int) randomBelow(rng, N_CORNER_PERM));
+    setURtoBR(result, (int) randomBelow(rng, N_EDGE_PERM));
+    setTwist(result, (short) randomBelow(rng, N_TWIST));
+    setFlip(result, (short) randomBelow(rng, N_FLIP));
+    if (edgeParity(result) != cornerParity(result)) {
+        e = result->ep[BL];
+        result->ep[BL] = result->ep[BR];
+        result->ep[BR] = e;
+    }
+}
+
+void randomFacelets(xoshiro_t* rng, char* facelets)
+{
+    cubiecube_t cc;
+    randomCubieCube(rng, &cc);
+    cubieToString(&cc, facelets);
+}
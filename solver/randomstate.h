@@ -0,0 +1,31 @@
+#ifndef RANDOMSTATE_H
+#define RANDOMSTATE_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// Uniformly distributed random cubes. Corner and edge permutation, twist and flip are drawn as uniform
+// coordinates and set with the set* functions of cubiecube.cpp, then the parity of the edges is fixed by swapping
+// two edges. The swap is a bijection between cubes of odd and even parity, so every solvable cube is drawn with the
+// same probability.
+
+// xoshiro256** generator, seeded by splitmix64
+typedef struct {
+    uint64_t s[4];
+} xoshiro_t;
+
+void seedRandom(xoshiro_t* rng, uint64_t seed);
+uint64_t nextRandom(xoshiro_t* rng);
+
+// Uniform number in [0, n)
+uint64_t randomBelow(xoshiro_t* rng, uint64_t n);
+
+// Generator of the calling thread, seeded from std::random_device on first use
+xoshiro_t* threadRandom(void);
+
+void randomCubieCube(xoshiro_t* rng, cubiecube_t* result);
+
+// Cube definition string of a random cube, facelets needs room for 55 characters
+void randomFacelets(xoshiro_t* rng, char* facelets);
+
+#endif
@@ -0,0 +1,127 @@
+#include <string.h>
+#include <mutex>
+#include "rubik_solver.h"
+#include "search.h"
+#include "coordcube.h"
+#include "facecube.h"
+#include "validate.h"
+#include "nearsolved.h"
+#include "notation.h"
+#include "sequence.h"
+#include "optimize.h"
+
+namespace rubik {
+
+const char* errorMessage(SolveError error)
+{
+    return solveStatusMessage((solvestatus_t) error);
+}
+
+CubeState::CubeState()
+{
+    compileSequence(NULL, 0, &cube_);
+}
+
+SolveError CubeState::parse(std::string_view facelets, CubeState& out)
+{
+    char text[55];
+    cubiecube_t cc;
+    if (facelets.size() != 54)
+        return SolveError::FaceletCount;
+    memcpy(text, facelets.data(), 54);
+    text[54] = '\0';
+    solvestatus_t status = parseFacelets(text, &cc);
+    if (status == SOLVE_OK)
+        out.cube_ = cc;
+    return (SolveError) status;
+}
+
+std::string CubeState::facelets() const
+{
+    char text[55];
+    cubiecube_t cube = cube_;
+    cubieToString(&cube, text);
+    return text;
+}
+
+void CubeState::apply(int mv)
+{
+    appendMove(&cube_, mv);
+}
+
+void CubeState::apply(MoveSpan moves)
+{
+    for (uint8_t mv : moves)
+        appendMove(&cube_, mv);
+}
+
+bool CubeState::isSolved() const
+{
+    cubiecube_t cube = cube_;
+    return solvesCube(&cube, NULL, 0) != 0;
+}
+
+SolveResult::SolveResult(char* text, const uint8_t* moves, int length) : error_(SolveError::None), text_(text),
+        length_(length)
+{
+    memcpy(moves_, moves, (size_t) length);
+}
+
+// Result of a solver function which returned text, solveStatus() tells why if it is NULL
+static SolveResult makeResult(char* text)
+{
+    uint8_t moves[MAX_SOLVE_DEPTH];
+    int n;
+    if (text == NULL)
+        return SolveResult((SolveError) solveStatus());
+    if ((n = parseMoves(text, moves, MAX_SOLVE_DEPTH)) < 0) {// the search never returns more than maxDepth moves
+        free(text);
+        return SolveResult(SolveError::MaxDepth);
+    }
+    return SolveResult(text, moves, n);
+}
+
+Solver::Solver(const std::string& cacheDir) : cacheDir_(cacheDir)
+{
+    static std::once_flag tables;
+    std::call_once(tables, [&cacheDir] {
+        if (PRUNING_INITED == 0)
+            initPruning(cacheDir.c_str());
+        ensureNearSolved();
+    });
+}
+
+// The options the search accepts, the result holds at most MAX_SOLVE_DEPTH moves
+static bool validOptions(const SolveOptions& options)
+{
+    return options.maxDepth >= 0 && options.maxDepth <= MAX_SOLVE_DEPTH;
+}
+
+SolveResult Solver::solve(const CubeState& cube, const SolveOptions& options) const
+{
+    if (!validOptions(options))
+        return SolveResult(SolveError::InvalidArgument);
+    cubiecube_t cc = cube.cubie();
+    return makeResult(solutionCubie(&cc, options.maxDepth, options.timeoutSeconds, options.separator,
+            cacheDir_.c_str(), NULL));
+}
+
+SolveResult Solver::solve(std::string_view facelets, const SolveOptions& options) const
+{
+    CubeState cube;
+    SolveError error = CubeState::parse(facelets, cube);
+    if (error != SolveError::None)
+        return SolveResult(error);
+    return solve(cube, options);
+}
+
+SolveResult Solver::solve(const CubeState& start, const CubeState& target, const SolveOptions& options) const
+{
+    if (!validOptions(options))
+        return SolveResult(SolveError::InvalidArgument);
+    cubiecube_t a = start.cubie(), b = target.cubie();
+    return makeResult(solutionToCubie(&a, &b, options.maxDepth, options.timeoutSeconds, options.separator,
+            cacheDir_.c_str()));
+}
+
+} // namespace rubik
@@ -0,0 +1,128 @@
+#ifndef RUBIK_SOLVER_H
+#define RUBIK_SOLVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "cubiecube.h"
+
+// C++ interface of the rubik_solver library. It wraps the C style solver functions: results own their memory, errors
+// are typed, and moves are handed out as spans of move codes (3 * axis + power - 1, see notation.h) which point into
+// the result, so nothing is copied and nothing has to be freed by the caller.
+//
+//   rubik::Solver solver("cache");
+//   rubik::CubeState cube;
+//   if (rubik::CubeState::parse(facelets, cube) == rubik::SolveError::None) {
+//       rubik::SolveResult result = solver.solve(cube);
+//       if (result)
+//           for (uint8_t mv : result.moves()) ...
+//   }
+
+namespace rubik {
+
+// The error codes documented for solution() in search.h
+enum class SolveError {
+    None = 0,
+    FaceletCount = 1,       // there is not exactly one facelet of each colour
+    EdgeMissing = 2,        // not all 12 edges exist exactly once
+    EdgeFlip = 3,           // one edge has to be flipped
+    CornerMissing = 4,      // not all corners exist exactly once
+    CornerTwist = 5,        // one corner has to be twisted
+    Parity = 6,             // two corners or two edges have to be exchanged
+    MaxDepth = 7,           // no solution exists for the given maxDepth
+    Timeout = 8,            // no solution within the given time
+    InvalidArgument = 9     // an option is out of range
+};
+
+const char* errorMessage(SolveError error);
+
+// Read only view of move codes
+class MoveSpan {
+public:
+    MoveSpan() : data_(nullptr), size_(0) {}
+    MoveSpan(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t operator[](size_t i) const { return data_[i]; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+// A cube on the cubie level, the solved cube after construction
+class CubeState {
+public:
+    CubeState();
+    explicit CubeState(const cubiecube_t& cube) : cube_(cube) {}
+
+    // Read a cube definition string (see facelet.h). Returns the error code 1..6 of solution() and leaves out
+    // unchanged if it is not a valid cube.
+    static SolveError parse(std::string_view facelets, CubeState& out);
+
+    std::string facelets() const;
+    void apply(int mv);
+    void apply(MoveSpan moves);
+    bool isSolved() const;
+    const cubiecube_t& cubie() const { return cube_; }
+
+private:
+    cubiecube_t cube_;
+};
+
+// Longest maxDepth of SolveOptions, the search keeps a move of every depth in arrays of search_t (search.h)
+constexpr int MAX_SOLVE_DEPTH = 30;
+
+struct SolveOptions {
+    int maxDepth = 21;          // 0..MAX_SOLVE_DEPTH, else solve returns SolveError::InvalidArgument
+    long timeoutSeconds = 10;
+    bool separator = false;     // keep the " . " between the phases in text()
+};
+
+// Outcome of a solve. Moves the solution string of the solver instead of copying it.
+class SolveResult {
+public:
+    SolveResult() : error_(SolveError::None), length_(0) {}
+    explicit SolveResult(SolveError error) : error_(error), length_(0) {}
+    SolveResult(char* text, const uint8_t* moves, int length);
+
+    explicit operator bool() const { return error_ == SolveError::None; }
+    SolveError error() const { return error_; }
+    MoveSpan moves() const { return MoveSpan(moves_, (size_t) length_); }
+    // the solution as the solver wrote it, e.g. "R2 U' F ", empty on error
+    std::string_view text() const { return text_ ? std::string_view(text_.get()) : std::string_view(); }
+
+private:
+    struct FreeText {
+        void operator()(char* text) const { free(text); }
+    };
+    SolveError error_;
+    std::unique_ptr<char, FreeText> text_;
+    uint8_t moves_[MAX_SOLVE_DEPTH] = {};
+    int length_;
+};
+
+// Handle of the solver tables. The tables are global: the first Solver loads them from cacheDir (or generates and
+// caches them there), later ones share them. Any number of threads may call solve on one Solver at once.
+class Solver {
+public:
+    explicit Solver(const std::string& cacheDir = "cache");
+
+    SolveResult solve(const CubeState& cube, const SolveOptions& options = SolveOptions()) const;
+    SolveResult solve(std::string_view facelets, const SolveOptions& options = SolveOptions()) const;
+    // maneuver which transforms start into target
+    SolveResult solve(const CubeState& start, const CubeState& target,
+            const SolveOptions& options = SolveOptions()) const;
+
+private:
+    std::string cacheDir_;
+};
+
+} // namespace rubik
+
+#endif
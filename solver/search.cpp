@@ -1,48 +1,127 @@
 #include <time.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "search.h"
 #include "color.h"
 #include "facecube.h"
 #include "coordcube.h"
+#include "successors.h"
+#include "transposition.h"
+#include "nearsolved.h"
+#include "solutioncache.h"
+#include "optimize.h"
 
 #define MIN(a, b) (((a)<(b))?(a):(b))
 #define MAX(a, b) (((a)>(b))?(a):(b))
 
+#if defined(SEARCH_NO_PREFETCH)
+#define PREFETCH(addr) ((void) 0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define PREFETCH(addr) _mm_prefetch((const char*) (addr), _MM_HINT_T0)
+#else
+#define PREFETCH(addr) ((void) 0)
+#endif
+
+// statements which only update search->stats
+#if defined(SEARCH_NO_STATS)
+#define STAT(stmt) ((void) 0)
+#else
+#define STAT(stmt) stmt
+#endif
+
+// Evaluate all successors of node n and keep the moves of those which can still reach the H subgroup with the
+// last of the depthPhase1 moves. The list keeps the move order of the search, so the solutions do not change.
+// Successors which reach H too early (within the last 5 moves) are dropped, phase2 covers these maneuvers.
+static void expandPhase1(search_t* search, int n, int depthPhase1)
+{
+    int mv, count = 0;
+    int left = depthPhase1 - n - 1;// moves left after the successor
+    phase1Successors(search->flip[n], search->twist[n], search->slice[n],
+            search->flipNext[n], search->twistNext[n], search->sliceNext[n], search->distNext[n]);
+    for (mv = 0; mv < N_MOVE; mv++) {
+        int ax = mv / 3;
+        int dist = search->distNext[n][mv];
+        if (n != 0 && (search->ax[n - 1] == ax || search->ax[n - 1] - 3 == ax))
+            continue;
+        if (dist > left || (dist == 0 && left > 0 && left <= 4)) {
+            STAT(search->stats.phase1Pruned++);
+            continue;
+        }
+        search->succ[n][count++] = (char) mv;
+    }
+    search->succCount[n] = count;
+    search->succNext[n] = 0;
+    search->leafSeen[n] = 0;
+}
+
+// Same for the phase2 coordinates. Only the moves U,D,R2,F2,L2 and B2 are expanded.
+static void expandPhase2(search_t* search, int n)
+{
+    static const int phase2Moves[10] = { 0, 1, 2, 4, 7, 9, 10, 11, 13, 16 };
+    int i;
+    for (i = 0; i < 10; i++) {
+        int mv = phase2Moves[i];
+        short URFtoDLF = URFtoDLF_Move[search->URFtoDLF[n]][mv];
+        short FRtoBR = FRtoBR_Move[search->FRtoBR[n]][mv];
+        short parity = parityMove[search->parity[n]][mv];
+        short URtoDF = URtoDF_Move[search->URtoDF[n]][mv];
+        search->URFtoDLFNext[n][mv] = URFtoDLF;
+        search->FRtoBRNext[n][mv] = FRtoBR;
+        search->parityNext[n][mv] = parity;
+        search->URtoDFNext[n][mv] = URtoDF;
+        PREFETCH(&Slice_URtoDF_Parity_Prun[((N_SLICE2 * URtoDF + FRtoBR) * 2 + parity) / 2]);
+        PREFETCH(&Slice_URFtoDLF_Parity_Prun[((N_SLICE2 * URFtoDLF + FRtoBR) * 2 + parity) / 2]);
+    }
+}
+
 char* solutionToString(search_t* search, int length, int depthPhase1)
 {
-    char* s = (char*) calloc(length * 3 + 5, 1);
-    int cur = 0, i;
-    for (i = 0; i < length; i++) {
-        switch (search->ax[i]) {
+    static const char axisName[] = "URFDLB";
+    char* s;
+    uint8_t moves[31];
+    int cur = 0, i, n;
+
+    if (length < 0 || length > (int) sizeof(moves)) {// more moves than search_t holds
+        setSolveStatus(SOLVE_INVALID_ARGUMENT);
+        return NULL;
+    }
+    // merge moves of the same face, also across an opposite face move; with the separator the two phases are
+    // optimized on their own so that the separator stays where phase1 ends
+    for (i = 0; i < length; i++)
+        moves[i] = (uint8_t) (3 * search->ax[i] + search->po[i] - 1);
+    if (depthPhase1 > 0 && depthPhase1 < length) {
+        int n1 = optimizeMoves(moves, depthPhase1);
+        int n2 = optimizeMoves(moves + depthPhase1, length - depthPhase1);
+        memmove(moves + n1, moves + depthPhase1, (size_t) n2);
+        depthPhase1 = n1;
+        n = n1 + n2;
+    } else {
+        n = optimizeMoves(moves, length);
+        if (depthPhase1 > n)
+            depthPhase1 = n;
+    }
+
+    s = (char*) calloc(n * 3 + 5, 1);
+    for (i = 0; i < n; i++) {
+        s[cur++] = axisName[moves[i] / 3];
+        switch (moves[i] % 3) {
         case 0:
-            s[cur++] = 'U';
-            break;
-        case 1:
-            s[cur++] = 'R';
-            break;
-        case 2:
-            s[cur++] = 'F';
-            break;
-        case 3:
-            s[cur++] = 'D';
-            break;
-        case 4:
-            s[cur++] = 'L';
-            break;
-        case 5:
-            s[cur++] = 'B';
-            break;
-        }
-        switch (search->po[i]) {
-        case 1:
             s[cur++] = ' ';
             break;
-        case 2:
+        case 1:
             s[cur++] = '2';
             s[cur++] = ' ';
             break;
-        case 3:
+        case 2:
             s[cur++] = '\'';
             s[cur++] = ' ';
             break;
@@ -56,58 +135,122 @@ char* solutionToString(search_t* search, int length, int depthPhase1)
 }
 
 
+// Phase2 runs in totalDepth, the rest of the search time is accounted to phase1.
+static int timedTotalDepth(search_t* search, int depthPhase1, int maxDepth)
+{
+#if defined(SEARCH_NO_STATS)
+    return totalDepth(search, depthPhase1, maxDepth);
+#else
+    auto start = std::chrono::steady_clock::now();
+    int s = totalDepth(search, depthPhase1, maxDepth);
+    search->stats.phase2Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return s;
+#endif
+}
+
+// Hand the counters of the search to the caller and free the search.
+static char* finishSearch(search_t* search, searchstats_t* stats, std::chrono::steady_clock::time_point start,
+        char* res)
+{
+    if (stats != NULL) {
+        *stats = search->stats;
+#if !defined(SEARCH_NO_STATS)
+        stats->phase1Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                - stats->phase2Seconds;
+#endif
+    }
+    free(search);
+    return res;
+}
+
 char* solution(char* facelets, int maxDepth, long timeOut, int useSeparator, const char* cache_dir)
+{
+    return solutionStats(facelets, maxDepth, timeOut, useSeparator, cache_dir, NULL);
+}
+
+static thread_local solvestatus_t lastStatus = SOLVE_OK;
+
+solvestatus_t solveStatus(void)
+{
+    return lastStatus;
+}
+
+void setSolveStatus(solvestatus_t status)
+{
+    lastStatus = status;
+}
+
+// Cubie cube of a cube definition string, NULL if it is not a valid cube
+static cubiecube_t* parseCube(char* facelets)
+{
+    cubiecube_t* cc = (cubiecube_t*) malloc(sizeof(cubiecube_t));
+    if ((lastStatus = parseFacelets(facelets, cc)) != SOLVE_OK) {
+        free(cc);
+        return NULL;
+    }
+    return cc;
+}
+
+char* solutionStats(char* facelets, int maxDepth, long timeOut, int useSeparator, const char* cache_dir,
+        searchstats_t* stats)
+{
+    cubiecube_t* cc = parseCube(facelets);
+    char* res;
+    if (cc == NULL) {
+        if (stats != NULL) {
+            *stats = searchstats_t();
+            stats->depthPhase1 = -1;
+        }
+        return NULL;
+    }
+    res = solutionCubie(cc, maxDepth, timeOut, useSeparator, cache_dir, stats);
+    free(cc);
+    return res;
+}
+
+// Deadline timeOutMs from now. Limits beyond a year are cut to a year so that the time point does not overflow.
+static std::chrono::steady_clock::time_point deadlineAfter(long timeOutMs)
+{
+    const long long year = 365LL * 24 * 3600 * 1000;
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(timeOutMs < year ? (long long) timeOutMs : year);
+}
+
+static char* searchCubie(cubiecube_t* cc, int maxDepth, long timeOutMs, int useSeparator, const char* cache_dir,
+        searchstats_t* stats)
 {
     search_t* search = (search_t*) calloc(1, sizeof(search_t));
-    facecube_t* fc;
-    cubiecube_t* cc;
     coordcube_t* c;
 
     int s, i;
     int mv, n;
-    int busy;
     int depthPhase1;
-    time_t tStart;
+    int nearMoves[31];
+    long backtracks = 0;
+    std::chrono::steady_clock::time_point clockStart, deadline;
+
+    clockStart = std::chrono::steady_clock::now();
+    search->stats.depthPhase1 = -1;
+
     // +++++++++++++++++++++check for wrong input +++++++++++++++++++++++++++++
-    int count[6] = {0};
+    if ((lastStatus = validateCubie(cc)) != SOLVE_OK)
+        return finishSearch(search, stats, clockStart, NULL);
 
     if (PRUNING_INITED == 0) {
         initPruning(cache_dir);
     }
-
-    for (i = 0; i < 54; i++)
-        switch(facelets[i]) {
-            case 'U':
-                count[U]++;
-                break;
-            case 'R':
-                count[R]++;
-                break;
-            case 'F':
-                count[F]++;
-                break;
-            case 'D':
-                count[D]++;
-                break;
-            case 'L':
-                count[L]++;
-                break;
-            case 'B':
-                count[B]++;
-                break;
-        }
-
-    for (i = 0; i < 6; i++)
-        if (count[i] != 9) {
-            free(search);
-            return NULL;
+    lastStatus = SOLVE_OK;
+
+    // +++++++++++++++++++++ cubes close to solved ++++++++++++++++++++++++++++
+    ensureNearSolved();
+    if ((s = nearSolvedSolve(cc, nearMoves)) >= 0 && s <= maxDepth) {// optimal, no need for the two-phase search
+        char* res;
+        for (i = 0; i < s; i++) {
+            search->ax[i] = nearMoves[i] / 3;
+            search->po[i] = nearMoves[i] % 3 + 1;
         }
-
-    fc = get_facecube_fromstring(facelets);
-    cc = toCubieCube(fc);
-    if ((s = verify(cc)) != 0) {
-        free(search);
-        return NULL;
+        res = solutionToString(search, s, -1);
+        search->stats.nearSolved = 1;
+        return finishSearch(search, stats, clockStart, res);
     }
 
     // +++++++++++++++++++++++ initialization +++++++++++++++++++++++++++++++++
@@ -124,88 +267,74 @@ char* solution(char* facelets, int maxDepth, long timeOut, int useSeparator, con
     search->URtoUL[0] = c->URtoUL;
     search->UBtoDF[0] = c->UBtoDF;
 
-    search->minDistPhase1[1] = 1;// else failure for depth=1, n=0
     mv = 0;
     n = 0;
-    busy = 0;
     depthPhase1 = 1;
+    expandPhase1(search, 0, depthPhase1);
 
-    tStart = time(NULL);
+    deadline = deadlineAfter(timeOutMs);
 
     // +++++++++++++++++++ Main loop ++++++++++++++++++++++++++++++++++++++++++
     do {
-        do {
-            if ((depthPhase1 - n > search->minDistPhase1[n + 1]) && !busy) {
-
-                if (search->ax[n] == 0 || search->ax[n] == 3)// Initialize next move
-                    search->ax[++n] = 1;
-                else
-                    search->ax[++n] = 0;
-                search->po[n] = 1;
-            } else if (++search->po[n] > 3) {
-                do {// increment axis
-                    if (++search->ax[n] > 5) {
-
-                        if (time(NULL) - tStart > timeOut)
-                            return NULL;
-
-                        if (n == 0) {
-                            if (depthPhase1 >= maxDepth)
-                                return NULL;
-                            else {
-                                depthPhase1++;
-                                search->ax[n] = 0;
-                                search->po[n] = 1;
-                                busy = 0;
-                                break;
-                            }
-                        } else {
-                            n--;
-                            busy = 1;
-                            break;
-                        }
+        if (search->succNext[n] == search->succCount[n]) {// all successors of node n are done
+            if ((++backtracks & 15) == 0 && std::chrono::steady_clock::now() > deadline) {
+                free(c);
+                lastStatus = SOLVE_TIMEOUT;
+                return finishSearch(search, stats, clockStart, NULL);
+            }
 
-                    } else {
-                        search->po[n] = 1;
-                        busy = 0;
-                    }
-                } while (n != 0 && (search->ax[n - 1] == search->ax[n] || search->ax[n - 1] - 3 == search->ax[n]));
-            } else
-                busy = 0;
-        } while (busy);
+            if (n == 0) {
+                if (depthPhase1 >= maxDepth) {
+                    free(c);
+                    lastStatus = SOLVE_MAX_DEPTH;
+                    return finishSearch(search, stats, clockStart, NULL);
+                }
+                expandPhase1(search, 0, ++depthPhase1);
+            } else {
+                if (!search->leafSeen[n] && depthPhase1 - n >= transpositionMinLeft())
+                    storeTransposition(search->flip[n], search->twist[n], search->slice[n], depthPhase1 - n, search->ax[n - 1]);
+                search->leafSeen[n - 1] |= search->leafSeen[n];
+                n--;
+            }
+            continue;
+        }
 
-        // +++++++++++++ compute new coordinates and new minDistPhase1 ++++++++++
+        // +++++++++++++ take the new coordinates and new minDistPhase1 +++++++
         // if minDistPhase1 =0, the H subgroup is reached
-        mv = 3 * search->ax[n] + search->po[n] - 1;
-        search->flip[n + 1] = flipMove[search->flip[n]][mv];
-        search->twist[n + 1] = twistMove[search->twist[n]][mv];
-        search->slice[n + 1] = FRtoBR_Move[search->slice[n] * 24][mv] / 24;
-        search->minDistPhase1[n + 1] = MAX(
-            getPruning(Slice_Flip_Prun, N_SLICE1 * search->flip[n + 1] + search->slice[n + 1]),
-            getPruning(Slice_Twist_Prun, N_SLICE1 * search->twist[n + 1] + search->slice[n + 1])
-        );
+        // Note: a second (dual) lookup for the inverse position is not an admissible bound here. The goal of phase1
+        // is the coset of H and the phase1 coordinates of the inverse describe the distance of the other coset
+        // (e.g. U' R' reaches H in 1 move, its inverse R U needs 2). In phase2 the dual lookup is admissible but
+        // never larger, because corner, edge and slice permutations are group homomorphisms of H.
+        mv = search->succ[n][search->succNext[n]++];
+        STAT(search->stats.phase1Nodes[n + 1]++);
+        search->ax[n] = mv / 3;
+        search->po[n] = mv % 3 + 1;
+        search->flip[n + 1] = search->flipNext[n][mv];
+        search->twist[n + 1] = search->twistNext[n][mv];
+        search->slice[n + 1] = search->sliceNext[n][mv];
+        search->minDistPhase1[n + 1] = search->distNext[n][mv];
         // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        // System.out.format("%d %d\n", n, depthPhase1);
-        if (search->minDistPhase1[n + 1] == 0 && n >= depthPhase1 - 5) {
-            search->minDistPhase1[n + 1] = 10;// instead of 10 any value >5 is possible
-            if (n == depthPhase1 - 1 && (s = totalDepth(search, depthPhase1, maxDepth)) >= 0) {
+        if (n == depthPhase1 - 1) {// the list of the last move only holds successors in H
+            search->leafSeen[n] = 1;
+            if ((s = timedTotalDepth(search, depthPhase1, maxDepth)) >= 0) {
                 if (s == depthPhase1
                         || (search->ax[depthPhase1 - 1] != search->ax[depthPhase1] && search->ax[depthPhase1 - 1] != search->ax[depthPhase1] + 3)) {
                     char* res;
-                    free((void*) fc);
-                    free((void*) cc);
                     free((void*) c);
                     if (useSeparator) {
                         res = solutionToString(search, s, depthPhase1);
                     } else {
                         res = solutionToString(search, s, -1);
                     }
-                    free((void*) search);
-                    return res;
+                    search->stats.depthPhase1 = depthPhase1;
+                    return finishSearch(search, stats, clockStart, res);
                 }
             }
-
-        }
+        } else if (depthPhase1 - n - 1 < transpositionMinLeft()
+                || !probeTransposition(search->flip[n + 1], search->twist[n + 1], search->slice[n + 1], depthPhase1 - n - 1, search->ax[n]))
+            expandPhase1(search, ++n, depthPhase1);
+        else
+            STAT(search->stats.transpositionCuts++);
     } while (1);
 }
 
@@ -216,6 +345,7 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
     int depthPhase2;
     int n;
     int busy;
+    STAT(search->stats.totalDepthCalls++);
     for (i = 0; i < depthPhase1; i++) {
         mv = 3 * search->ax[i] + search->po[i] - 1;
         // System.out.format("%d %d %d %d\n", i, mv, ax[i], po[i]);
@@ -225,8 +355,10 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
     }
 
     if ((d1 = getPruning(Slice_URFtoDLF_Parity_Prun,
-            (N_SLICE2 * search->URFtoDLF[depthPhase1] + search->FRtoBR[depthPhase1]) * 2 + search->parity[depthPhase1])) > maxDepthPhase2)
+            (N_SLICE2 * search->URFtoDLF[depthPhase1] + search->FRtoBR[depthPhase1]) * 2 + search->parity[depthPhase1])) > maxDepthPhase2) {
+        STAT(search->stats.phase2Pruned++);
         return -1;
+    }
 
     for (i = 0; i < depthPhase1; i++) {
         mv = 3 * search->ax[i] + search->po[i] - 1;
@@ -236,8 +368,10 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
     search->URtoDF[depthPhase1] = MergeURtoULandUBtoDF[search->URtoUL[depthPhase1]][search->UBtoDF[depthPhase1]];
 
     if ((d2 = getPruning(Slice_URtoDF_Parity_Prun,
-            (N_SLICE2 * search->URtoDF[depthPhase1] + search->FRtoBR[depthPhase1]) * 2 + search->parity[depthPhase1])) > maxDepthPhase2)
+            (N_SLICE2 * search->URtoDF[depthPhase1] + search->FRtoBR[depthPhase1]) * 2 + search->parity[depthPhase1])) > maxDepthPhase2) {
+        STAT(search->stats.phase2Pruned++);
         return -1;
+    }
 
     if ((search->minDistPhase2[depthPhase1] = MAX(d1, d2)) == 0)// already solved
         return depthPhase1;
@@ -250,6 +384,7 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
     search->po[depthPhase1] = 0;
     search->ax[depthPhase1] = 0;
     search->minDistPhase2[n + 1] = 1;// else failure for depthPhase2=1, n=0
+    expandPhase2(search, n);
     // +++++++++++++++++++ end initialization +++++++++++++++++++++++++++++++++
     do {
         do {
@@ -263,6 +398,7 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
                     search->ax[++n] = 0;
                     search->po[n] = 1;
                 }
+                expandPhase2(search, n);
             } else if ((search->ax[n] == 0 || search->ax[n] == 3) ? (++search->po[n] > 3) : ((search->po[n] = search->po[n] + 2) > 3)) {
                 do {// increment axis
                     if (++search->ax[n] > 5) {
@@ -295,11 +431,12 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
         } while (busy);
         // +++++++++++++ compute new coordinates and new minDist ++++++++++
         mv = 3 * search->ax[n] + search->po[n] - 1;
+        STAT(search->stats.phase2Nodes++);
 
-        search->URFtoDLF[n + 1] = URFtoDLF_Move[search->URFtoDLF[n]][mv];
-        search->FRtoBR[n + 1] = FRtoBR_Move[search->FRtoBR[n]][mv];
-        search->parity[n + 1] = parityMove[search->parity[n]][mv];
-        search->URtoDF[n + 1] = URtoDF_Move[search->URtoDF[n]][mv];
+        search->URFtoDLF[n + 1] = search->URFtoDLFNext[n][mv];
+        search->FRtoBR[n + 1] = search->FRtoBRNext[n][mv];
+        search->parity[n + 1] = search->parityNext[n][mv];
+        search->URtoDF[n + 1] = search->URtoDFNext[n][mv];
 
         search->minDistPhase2[n + 1] = MAX(getPruning(Slice_URtoDF_Parity_Prun, (N_SLICE2
                 * search->URtoDF[n + 1] + search->FRtoBR[n + 1])
@@ -312,6 +449,85 @@ int totalDepth(search_t* search, int depthPhase1, int maxDepth)
     return depthPhase1 + depthPhase2;
 }
 
+char* solutionCubie(cubiecube_t* cc, int maxDepth, long timeOut, int useSeparator, const char* cache_dir,
+        searchstats_t* stats)
+{
+    return solutionCubieMs(cc, maxDepth, timeOut < LONG_MAX / 1000 ? timeOut * 1000 : LONG_MAX, useSeparator, cache_dir,
+            stats);
+}
+
+char* solutionCubieMs(cubiecube_t* cc, int maxDepth, long timeOutMs, int useSeparator, const char* cache_dir,
+        searchstats_t* stats)
+{
+    char* res = lookupSolution(cc, maxDepth, useSeparator);
+    if (res != NULL) {
+        if (stats != NULL) {
+            *stats = searchstats_t();
+            stats->depthPhase1 = -1;
+            stats->cached = 1;
+        }
+        lastStatus = SOLVE_OK;
+        return res;
+    }
+    res = searchCubie(cc, maxDepth, timeOutMs, useSeparator, cache_dir, stats);
+    storeSolution(cc, maxDepth, useSeparator, res);
+    return res;
+}
+
+char* solutionToCubie(cubiecube_t* start, cubiecube_t* target, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir)
+{
+    cubiecube_t delta;
+    if ((lastStatus = validateCubie(start)) != SOLVE_OK || (lastStatus = validateCubie(target)) != SOLVE_OK)
+        return NULL;
+    invCubieCube(target, &delta);
+    multiply(&delta, start);
+    return solutionCubie(&delta, maxDepth, timeOut, useSeparator, cache_dir, NULL);
+}
+
+char* solutionToPattern(char* facelets, char* pattern, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir)
+{
+    cubiecube_t* start = parseCube(facelets);
+    cubiecube_t* target = start != NULL ? parseCube(pattern) : NULL;
+    char* res = NULL;
+    if (start != NULL && target != NULL)
+        res = solutionToCubie(start, target, maxDepth, timeOut, useSeparator, cache_dir);
+    free(start);
+    free(target);
+    return res;
+}
+
+void solutionsToCubies(cubiecube_t* start, cubiecube_t* targets, int count, char** results, int threads,
+        int maxDepth, long timeOut, int useSeparator, const char* cache_dir, solvestatus_t* statuses)
+{
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    int i;
+
+    // the pruning tables are initialized lazily, which must not happen in several threads at once
+    if (PRUNING_INITED == 0)
+        initPruning(cache_dir);
+    ensureNearSolved();
+    if (threads <= 0)
+        threads = (int) std::thread::hardware_concurrency();
+    threads = MAX(1, MIN(threads, count));
+
+    auto work = [&]() {
+        int k;
+        while ((k = next++) < count) {
+            results[k] = solutionToCubie(start, &targets[k], maxDepth, timeOut, useSeparator, cache_dir);
+            if (statuses != NULL)
+                statuses[k] = solveStatus();
+        }
+    };
+    for (i = 1; i < threads; i++)
+        workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
 void patternize(char* facelets, char* pattern, char* patternized)
 {
     facecube_t* fc;
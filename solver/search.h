@@ -1,6 +1,25 @@
 #ifndef SEARCH_H
 #define SEARCH_H
 
+#include "cubiecube.h"
+#include "validate.h"
+
+// Counters of a single solve, see solutionStats. Builds with SEARCH_NO_STATS (cmake -DSOLVER_STATS=OFF) do not count
+// in the search loops, there only depthPhase1 and nearSolved are filled in and everything else stays 0.
+typedef struct {
+    long long phase1Nodes[31];  // phase1 nodes by their depth, phase1Nodes[d] are the nodes reached with d moves
+    long long phase1Pruned;     // phase1 successors cut by the pruning tables
+    long long transpositionCuts;// phase1 nodes cut by the transposition table
+    long long totalDepthCalls;  // positions of the H subgroup handed to phase2
+    long long phase2Pruned;     // of these, the ones rejected by the phase2 pruning tables before any search
+    long long phase2Nodes;
+    int depthPhase1;            // phase1 length of the returned solution, -1 if there is none
+    int nearSolved;             // the solution came from the near solved table, there were no phases
+    int cached;                 // the solution came from the solution cache, there was no search at all
+    double phase1Seconds;       // wall time in phase1, including the setup of the coordinates
+    double phase2Seconds;       // wall time in totalDepth
+} searchstats_t;
+
 typedef struct {
     int ax[31];             // The axis of the move
     int po[31];             // The power of the move
@@ -15,11 +34,26 @@ typedef struct {
     int URtoDF[31];
     int minDistPhase1[31];  // IDA* distance do goal estimations
     int minDistPhase2[31];
+    short flipNext[31][18]; // coordinates of all successors of a node, computed ahead of the search loop
+    short twistNext[31][18];
+    short sliceNext[31][18];
+    signed char distNext[31][18];
+    char succ[31][18];      // phase1 moves of a node which pass the pruning, in search order
+    int succCount[31];
+    int succNext[31];
+    int leafSeen[31];       // a position of the H subgroup was reached at the last phase1 level below this node
+    short parityNext[31][18];
+    short URFtoDLFNext[31][18];
+    short FRtoBRNext[31][18];
+    short URtoDFNext[31][18];
+    searchstats_t stats;
 } search_t;
 
 search_t* get_search(void);
 
-// generate the solution string from the array data including a separator between phase1 and phase2 moves
+// generate the solution string from the array data including a separator between phase1 and phase2 moves.
+// The moves are run through optimizeMoves (optimize.h) first, each phase on its own if there is a separator.
+// Returns NULL and sets SOLVE_INVALID_ARGUMENT if length is more than the 31 moves of search_t.
 char* solutionToString(search_t* search, int length, int depthPhase1);
 /**
  * Computes the solver string for a given cube.
@@ -39,7 +73,7 @@ char* solutionToString(search_t* search, int length, int depthPhase1);
  * @param useSeparator
  *          determines if a " . " separates the phase1 and phase2 parts of the solver string like in F' R B R L2 F .
  *          U2 U D for example.<br>
- * @return The solution string or an error code:<br>
+ * @return The solution string or NULL. solveStatus() tells why there is no solution, with the error code:<br>
  *         Error 1: There is not exactly one facelet of each colour<br>
  *         Error 2: Not all 12 edges exist exactly once<br>
  *         Error 3: Flip error: One edge has to be flipped<br>
@@ -47,10 +81,48 @@ char* solutionToString(search_t* search, int length, int depthPhase1);
  *         Error 5: Twist error: One corner has to be twisted<br>
  *         Error 6: Parity error: Two corners or two edges have to be exchanged<br>
  *         Error 7: No solution exists for the given maxDepth<br>
- *         Error 8: Timeout, no solution within given time
+ *         Error 8: Timeout, no solution within given time<br>
+ *         The first call of the process builds the pruning tables (or loads them from cache_dir) and the near solved
+ *         table of nearsolved.h, 32 MB in about 0.25 s.
  */
 char* solution(char* facelets, int maxDepth, long timeOut, int useSeparator, const char* cache_dir);
 
+// Status of the last call of a solution function in this thread, SOLVE_OK if it returned a solution. Invalid cubes
+// are rejected before the pruning tables are loaded.
+solvestatus_t solveStatus(void);
+
+// Set the status, for the solution functions of other modules
+void setSolveStatus(solvestatus_t status);
+
+// Same as solution, and fills stats with the counters of this solve (also if no solution is returned).
+char* solutionStats(char* facelets, int maxDepth, long timeOut, int useSeparator, const char* cache_dir,
+        searchstats_t* stats);
+
+// Same as solutionStats for a cube given on the cubie level, stats may be NULL.
+// Solutions are looked up in and added to the solution cache (solutioncache.h) by all solution functions.
+char* solutionCubie(cubiecube_t* cubiecube, int maxDepth, long timeOut, int useSeparator, const char* cache_dir,
+        searchstats_t* stats);
+
+// Same as solutionCubie with the computing time in milliseconds, for time limits below a second
+char* solutionCubieMs(cubiecube_t* cubiecube, int maxDepth, long timeOutMs, int useSeparator, const char* cache_dir,
+        searchstats_t* stats);
+
+// Computes a maneuver which transforms the cube start into the cube target, i.e. the solution of inv(target) * start.
+// The error cases are the same as for solution(), for either cube.
+char* solutionToCubie(cubiecube_t* start, cubiecube_t* target, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir);
+
+// Same for two cube definition strings, e.g. a scrambled cube and a pattern like the checkerboard
+char* solutionToPattern(char* facelets, char* pattern, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir);
+
+// Solve one start cube to count target cubes concurrently with the given number of threads (0 for one per hardware
+// thread). results[i] receives the maneuver from start to targets[i] or NULL, the caller frees the strings.
+// statuses[i] receives the status of that solve if statuses is not NULL. solveStatus() of the calling thread is not
+// set, the workers solve in threads of their own.
+void solutionsToCubies(cubiecube_t* start, cubiecube_t* targets, int count, char** results, int threads,
+        int maxDepth, long timeOut, int useSeparator, const char* cache_dir, solvestatus_t* statuses);
+
 // Apply phase2 of algorithm and return the combined phase1 and phase2 depth. In phase2, only the moves
 // U,D,R2,F2,L2 and B2 are allowed.
 int totalDepth(search_t* search, int depthPhase1, int maxDepth);
@@ -0,0 +1,79 @@
+#include "sequence.h"
+#include "coordcube.h"
+
+// Below this length the moves are composed one after another
+#define SEQUENCE_LEAF 64
+
+typedef struct {
+    cubiecube_t cube[N_MOVE];
+} movecubies_t;
+
+const cubiecube_t* moveCubies(void)
+{
+    static const movecubies_t table = [] {
+        movecubies_t t;
+        cubiecube_t* moveCube = get_moveCube();
+        cubiecube_t* cc = get_cubiecube();
+        int ax, po;
+        for (ax = 0; ax < 6; ax++) {
+            cubiecube_t c = *cc;
+            for (po = 0; po < 3; po++) {
+                multiply(&c, &moveCube[ax]);
+                t.cube[3 * ax + po] = c;
+            }
+        }
+        free(cc);
+        return t;
+    }();
+    return table.cube;
+}
+
+// a = a * b for regular cubes. Sequences of moves never produce mirrored cubes, so the orientation cases of
+// cornerMultiply are not needed.
+static inline void composeRegular(cubiecube_t* a, const cubiecube_t* b)
+{
+    cubiecube_t r;
+    int i;
+    for (i = 0; i < CORNER_COUNT; i++) {
+        r.cp[i] = a->cp[b->cp[i]];
+        r.co[i] = a->co[b->cp[i]] + b->co[i];
+        if (r.co[i] >= 3)
+            r.co[i] -= 3;
+    }
+    for (i = 0; i < EDGE_COUNT; i++) {
+        r.ep[i] = a->ep[b->ep[i]];
+        r.eo[i] = a->eo[b->ep[i]] ^ b->eo[i];
+    }
+    *a = r;
+}
+
+static void compileRange(const cubiecube_t* moveCube, const unsigned char* moves, long n, cubiecube_t* result)
+{
+    long i;
+    if (n <= SEQUENCE_LEAF) {
+        *result = moveCube[moves[0]];
+        for (i = 1; i < n; i++)
+            composeRegular(result, &moveCube[moves[i]]);
+    } else {
+        cubiecube_t right;
+        compileRange(moveCube, moves, n / 2, result);
+        compileRange(moveCube, moves + n / 2, n - n / 2, &right);
+        composeRegular(result, &right);
+    }
+}
+
+void compileSequence(const unsigned char* moves, long n, cubiecube_t* result)
+{
+    if (n <= 0) {
+        cubiecube_t* id = get_cubiecube();
+        *result = *id;
+        free(id);
+        return;
+    }
+    compileRange(moveCubies(), moves, n, result);
+}
+
+void appendMove(cubiecube_t* compiled, int mv)
+{
+    composeRegular(compiled, &moveCubies()[mv]);
+}
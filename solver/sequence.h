@@ -0,0 +1,21 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include "cubiecube.h"
+
+// Compilation of a move sequence into one permutation. A compiled sequence is applied to any cube in O(1) with
+// multiply (cubie level) or, converted with faceletPermFromCubie, faceletApplyPerm (facelet level), however long
+// the sequence was.
+// Moves are given as 3 * axis + power - 1, like everywhere in the solver.
+
+// The 18 moves applied to the solved cube, moveCubies()[mv]. Built on the first call, which is thread-safe.
+const cubiecube_t* moveCubies(void);
+
+// Compose the moves into one cubie cube. Sequences are split in halves recursively and the halves are composed,
+// so the composition is a balanced tree of depth log(n).
+void compileSequence(const unsigned char* moves, long n, cubiecube_t* result);
+
+// Multiply one move onto a compiled sequence, i.e. append the move to the sequence
+void appendMove(cubiecube_t* compiled, int mv);
+
+#endif
@@ -0,0 +1,139 @@
+#include <stdlib.h>
+#include <string.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "solutioncache.h"
+#include "symmetry.h"
+#include "notation.h"
+
+typedef struct {
+    cubiekey_t cube;
+    int params;             // maxDepth and useSeparator
+} cachekey_t;
+
+struct cacheKeyHash {
+    size_t operator()(const cachekey_t& key) const
+    {
+        uint64_t h = key.cube.corners * 0x9E3779B97F4A7C15ULL ^ key.cube.edges;
+        h = (h ^ (h >> 29) ^ (uint64_t) key.params) * 0xBF58476D1CE4E5B9ULL;
+        return (size_t) (h ^ (h >> 32));
+    }
+};
+
+struct cacheKeyEqual {
+    bool operator()(const cachekey_t& a, const cachekey_t& b) const
+    {
+        return a.cube.corners == b.cube.corners && a.cube.edges == b.cube.edges && a.params == b.params;
+    }
+};
+
+typedef std::list<std::pair<cachekey_t, std::string>> lru_t;
+
+typedef struct {
+    std::mutex lock;
+    lru_t lru;              // most recently used entry first
+    std::unordered_map<cachekey_t, lru_t::iterator, cacheKeyHash, cacheKeyEqual> index;
+    long capacity;
+    long long hits, misses, evictions;
+} shard_t;
+
+static shard_t shards[SOLUTION_CACHE_SHARDS];
+static long shardCapacity = (SOLUTION_CACHE_DEFAULT + SOLUTION_CACHE_SHARDS - 1) / SOLUTION_CACHE_SHARDS;
+
+// The key is the canonical key of the cube, sym receives the symmetry which maps the cube to the canonical cube
+static shard_t* findShard(cubiecube_t* cubiecube, int maxDepth, int useSeparator, cachekey_t* key, int* sym)
+{
+    *sym = canonicalKey(cubiecube, &key->cube);
+    key->params = maxDepth * 2 + (useSeparator != 0);
+    return &shards[cacheKeyHash()(*key) % SOLUTION_CACHE_SHARDS];
+}
+
+// Conjugate every move of a solution string by symmetry s. The phase separator stays where it is.
+static std::string conjugateSolution(const char* solution, int s)
+{
+    std::string res;
+    const char* p = solution;
+    while (*p != '\0') {
+        const char* start;
+        int mv;
+        while (*p == ' ')
+            p++;
+        if (*p == '\0')
+            break;
+        start = p;
+        while (*p != '\0' && *p != ' ')
+            p++;
+        mv = parseMove(std::string_view(start, p - start));
+        res += mv < 0 ? std::string(start, p - start) : moveName(symmetryMove(s, mv));
+        res += ' ';
+    }
+    return res;
+}
+
+void initSolutionCache(long capacity)
+{
+    int i;
+    shardCapacity = capacity <= 0 ? 0 : (capacity + SOLUTION_CACHE_SHARDS - 1) / SOLUTION_CACHE_SHARDS;
+    for (i = 0; i < SOLUTION_CACHE_SHARDS; i++) {
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        shards[i].lru.clear();
+        shards[i].index.clear();
+        shards[i].hits = shards[i].misses = shards[i].evictions = 0;
+    }
+}
+
+char* lookupSolution(cubiecube_t* cubiecube, int maxDepth, int useSeparator)
+{
+    cachekey_t key;
+    shard_t* shard;
+    int sym;
+    if (shardCapacity == 0)
+        return NULL;
+    shard = findShard(cubiecube, maxDepth, useSeparator, &key, &sym);
+    std::lock_guard<std::mutex> guard(shard->lock);
+    auto it = shard->index.find(key);
+    if (it == shard->index.end()) {
+        shard->misses++;
+        return NULL;
+    }
+    shard->hits++;
+    shard->lru.splice(shard->lru.begin(), shard->lru, it->second);
+    if (sym == 0)
+        return strdup(it->second->second.c_str());
+    return strdup(conjugateSolution(it->second->second.c_str(), inverseSymmetry(sym)).c_str());
+}
+
+void storeSolution(cubiecube_t* cubiecube, int maxDepth, int useSeparator, const char* solution)
+{
+    cachekey_t key;
+    shard_t* shard;
+    int sym;
+    if (shardCapacity == 0 || solution == NULL)
+        return;
+    shard = findShard(cubiecube, maxDepth, useSeparator, &key, &sym);
+    std::lock_guard<std::mutex> guard(shard->lock);
+    if (shard->index.find(key) != shard->index.end())// stored by another thread meanwhile
+        return;
+    if ((long) shard->lru.size() >= shardCapacity) {
+        shard->index.erase(shard->lru.back().first);
+        shard->lru.pop_back();
+        shard->evictions++;
+    }
+    shard->lru.emplace_front(key, sym == 0 ? std::string(solution) : conjugateSolution(solution, sym));
+    shard->index[key] = shard->lru.begin();
+}
+
+void solutionCacheStats(cachestats_t* stats)
+{
+    int i;
+    memset(stats, 0, sizeof(cachestats_t));
+    for (i = 0; i < SOLUTION_CACHE_SHARDS; i++) {
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        stats->hits += shards[i].hits;
+        stats->misses += shards[i].misses;
+        stats->evictions += shards[i].evictions;
+        stats->entries += (long) shards[i].lru.size();
+    }
+}
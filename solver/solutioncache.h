@@ -0,0 +1,37 @@
+#ifndef SOLUTIONCACHE_H
+#define SOLUTIONCACHE_H
+
+#include "cubiecube.h"
+
+// Bounded cache of solution strings in front of the search, keyed by the canonical key of the cube (see
+// symmetry.h) and the search parameters which change the result (maxDepth and the separator). The solution of the
+// canonical cube is stored and conjugated back on a hit, so all 48 symmetric copies of a cube share one entry.
+// The phase separator of such a solution marks the end of phase1 of the copy which was searched.
+// Only found solutions are stored, so a retry after a timeout searches again.
+// The cache is split into SOLUTION_CACHE_SHARDS shards by the hash of the key. Every shard is an LRU list with its
+// own lock, so concurrent solves rarely wait for each other.
+
+#define SOLUTION_CACHE_SHARDS 16
+#define SOLUTION_CACHE_DEFAULT 4096 // entries of the cache before initSolutionCache is called
+
+typedef struct {
+    long long hits;
+    long long misses;
+    long long evictions;
+    long entries;
+} cachestats_t;
+
+// Drop all entries and bound the cache to capacity entries, 0 disables it. Resets the counters.
+// Must not be called while a search is running.
+void initSolutionCache(long capacity);
+
+// Copy of the cached solution (to be freed by the caller) or NULL
+char* lookupSolution(cubiecube_t* cubiecube, int maxDepth, int useSeparator);
+
+// Store a copy of the solution, evicting the least recently used entry of the shard if it is full
+void storeSolution(cubiecube_t* cubiecube, int maxDepth, int useSeparator, const char* solution);
+
+// Counters summed over all shards
+void solutionCacheStats(cachestats_t* stats);
+
+#endif
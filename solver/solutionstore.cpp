@@ -0,0 +1,372 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "solutionstore.h"
+#include "symmetry.h"
+#include "notation.h"
+#include "facecube.h"
+#include "search.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define STORE_MAGIC "RBKSTORE"
+#define STORE_VERSION 1
+#define SLOT_USED (1ULL << 63)  // tag bit of a published slot, the key corners use 40 bits
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t capacity;              // number of slots, a power of 2
+    std::atomic<uint64_t> count;    // published slots
+    uint8_t unused[32];
+} storeheader_t;
+
+typedef struct {
+    std::atomic<uint64_t> tag;      // key corners | SLOT_USED, 0 while the slot is empty
+    uint64_t edges;                 // key edges
+    uint8_t length;
+    int8_t phase1;
+    uint8_t maxDepth;
+    uint8_t flags;
+    uint32_t micros;
+    uint8_t moves[STORE_MAX_MOVES]; // solution of the canonical cube
+} storeslot_t;
+
+static_assert(sizeof(storeheader_t) == 64 && sizeof(storeslot_t) == 64, "store slots must be 64 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the tag words are shared between processes");
+
+// One mapping of a store file. Mappings replaced by a rehash stay mapped until the store is closed, threads of
+// this process may still be reading them.
+typedef struct {
+    void* base;
+    size_t size;
+    storeheader_t* header;
+    storeslot_t* slots;
+    uint64_t mask;
+} storemap_t;
+
+struct solutionstore {
+    std::string path;
+    int fd;
+    int writable;
+    std::atomic<storemap_t*> map;
+    std::vector<storemap_t*> maps;  // all mappings, the current one last
+    std::mutex appendLock;          // appends of the threads of the writer process
+};
+
+static inline uint64_t slotHash(const cubiekey_t* key)
+{
+    uint64_t h = key->corners * 0x9E3779B97F4A7C15ULL ^ key->edges * 0xC2B2AE3D27D4EB4FULL;
+    return h ^ (h >> 29);
+}
+
+#if !defined(_WIN32)
+
+static storemap_t* mapStore(int fd, int writable)
+{
+    struct stat st;
+    storemap_t* map;
+    void* base;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < 2 * sizeof(storeslot_t))
+        return NULL;
+    base = mmap(NULL, (size_t) st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    map = (storemap_t*) calloc(1, sizeof(storemap_t));
+    map->base = base;
+    map->size = (size_t) st.st_size;
+    map->header = (storeheader_t*) base;
+    map->slots = (storeslot_t*) ((char*) base + sizeof(storeheader_t));
+    if (memcmp(map->header->magic, STORE_MAGIC, 8) != 0 || map->header->version != STORE_VERSION
+            || map->header->slotSize != sizeof(storeslot_t)
+            || (map->header->capacity & (map->header->capacity - 1)) != 0
+            || sizeof(storeheader_t) + map->header->capacity * sizeof(storeslot_t) != map->size) {
+        munmap(base, map->size);
+        free(map);
+        return NULL;
+    }
+    map->mask = map->header->capacity - 1;
+    return map;
+}
+
+// Create an empty store file of capacity slots, returns the open descriptor or -1
+static int createStoreFile(const char* path, uint64_t capacity)
+{
+    storeheader_t header;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+    memset((void*) &header, 0, sizeof(header));
+    memcpy(header.magic, STORE_MAGIC, 8);
+    header.version = STORE_VERSION;
+    header.slotSize = sizeof(storeslot_t);
+    header.capacity = capacity;
+    // the slots are a hole of zeros, i.e. empty
+    if (ftruncate(fd, (off_t) (sizeof(storeheader_t) + capacity * sizeof(storeslot_t))) != 0
+            || pwrite(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+solutionstore_t* openSolutionStore(const char* path, int writable)
+{
+    solutionstore_t* store;
+    storemap_t* map;
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0 && writable)
+        fd = createStoreFile(path, STORE_DEFAULT_CAPACITY);
+    if (fd < 0)
+        return NULL;
+    if (writable && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return NULL;
+    }
+    if ((map = mapStore(fd, writable)) == NULL) {
+        close(fd);
+        return NULL;
+    }
+    store = new solutionstore();
+    store->path = path;
+    store->fd = fd;
+    store->writable = writable;
+    store->map.store(map);
+    store->maps.push_back(map);
+    return store;
+}
+
+void closeSolutionStore(solutionstore_t* store)
+{
+    if (store == NULL)
+        return;
+    if (store->writable)
+        msync(store->map.load()->base, store->map.load()->size, MS_SYNC);
+    for (storemap_t* map : store->maps) {
+        munmap(map->base, map->size);
+        free(map);
+    }
+    close(store->fd);
+    delete store;
+}
+
+// Find the slot of the key or the empty slot where it belongs, NULL if every slot is taken by another key. The
+// load factor keeps a store written by appendStoredSolution from filling up, but a file with a wrong count in its
+// header or a damaged file may, and readers must not spin on it.
+static storeslot_t* findSlot(storemap_t* map, const cubiekey_t* key)
+{
+    uint64_t i = slotHash(key) & map->mask, probes;
+    for (probes = 0; probes <= map->mask; probes++) {
+        storeslot_t* slot = &map->slots[i];
+        uint64_t tag = slot->tag.load(std::memory_order_acquire);
+        if (tag == 0 || (tag == (key->corners | SLOT_USED) && slot->edges == key->edges))
+            return slot;
+        i = (i + 1) & map->mask;
+    }
+    return NULL;
+}
+
+// Copy the published slots into a new file of twice the size and rename it over the store file.
+// The caller holds appendLock.
+static int growStore(solutionstore_t* store)
+{
+    storemap_t* old = store->map.load();
+    storemap_t* map;
+    std::string tmp = store->path + ".tmp";
+    uint64_t i, count = 0;
+    int fd = createStoreFile(tmp.c_str(), old->header->capacity * 2);
+    if (fd < 0)
+        return -1;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || (map = mapStore(fd, 1)) == NULL) {
+        close(fd);
+        unlink(tmp.c_str());
+        return -1;
+    }
+    for (i = 0; i <= old->mask; i++) {
+        storeslot_t* from = &old->slots[i];
+        uint64_t tag = from->tag.load(std::memory_order_relaxed);
+        cubiekey_t key;
+        storeslot_t* to;
+        if (tag == 0)
+            continue;
+        key.corners = tag & ~SLOT_USED;
+        key.edges = from->edges;
+        if ((to = findSlot(map, &key)) == NULL)// only if the old store held more keys than it has slots
+            break;
+        memcpy((char*) to + sizeof(to->tag), (char*) from + sizeof(from->tag), sizeof(storeslot_t) - sizeof(to->tag));
+        to->tag.store(tag, std::memory_order_relaxed);
+        count++;
+    }
+    map->header->count.store(count, std::memory_order_relaxed);
+    if (i <= old->mask || msync(map->base, map->size, MS_SYNC) != 0 || rename(tmp.c_str(), store->path.c_str()) != 0) {
+        munmap(map->base, map->size);
+        free(map);
+        close(fd);
+        unlink(tmp.c_str());
+        return -1;
+    }
+    close(store->fd);
+    store->fd = fd;
+    store->maps.push_back(map);
+    store->map.store(map, std::memory_order_release);
+    return 0;
+}
+
+#else
+
+solutionstore_t* openSolutionStore(const char* path, int writable)
+{
+    return NULL;
+}
+
+void closeSolutionStore(solutionstore_t* store)
+{
+}
+
+static storeslot_t* findSlot(storemap_t* map, const cubiekey_t* key)
+{
+    return NULL;
+}
+
+static int growStore(solutionstore_t* store)
+{
+    return -1;
+}
+
+#endif
+
+char* lookupStoredSolution(solutionstore_t* store, cubiecube_t* cubiecube, int maxDepth, int useSeparator,
+        storemeta_t* meta)
+{
+    cubiekey_t key;
+    storeslot_t* slot;
+    uint8_t moves[STORE_MAX_MOVES];
+    char* res;
+    int sym, i, cur = 0;
+    if (store == NULL)
+        return NULL;
+    sym = canonicalKey(cubiecube, &key);
+    slot = findSlot(store->map.load(std::memory_order_acquire), &key);
+    if (slot == NULL || slot->tag.load(std::memory_order_acquire) == 0 || slot->length > maxDepth)
+        return NULL;
+    memcpy(moves, slot->moves, slot->length);
+    conjugateMoves(inverseSymmetry(sym), moves, slot->length);
+    res = (char*) calloc(slot->length * 3 + 5, 1);
+    for (i = 0; i < slot->length; i++) {
+        const char* name = moveName(moves[i]);
+        strcpy(res + cur, name);
+        cur += (int) strlen(name);
+        res[cur++] = ' ';
+        if (useSeparator && i == slot->phase1 - 1) {
+            res[cur++] = '.';
+            res[cur++] = ' ';
+        }
+    }
+    if (meta != NULL) {
+        meta->length = slot->length;
+        meta->phase1 = slot->phase1;
+        meta->maxDepth = slot->maxDepth;
+        meta->micros = slot->micros;
+    }
+    return res;
+}
+
+int appendStoredSolution(solutionstore_t* store, cubiecube_t* cubiecube, const char* solution, int maxDepth,
+        unsigned micros)
+{
+    cubiekey_t key;
+    storeslot_t* slot;
+    storemap_t* map;
+    const char* separator;
+    uint8_t moves[STORE_MAX_MOVES];
+    int n, sym, i, phase1 = -1;
+    if (store == NULL || !store->writable || solution == NULL
+            || (n = parseMoves(solution, moves, STORE_MAX_MOVES)) < 0)
+        return -1;
+    if ((separator = strchr(solution, '.')) != NULL)
+        for (phase1 = 0, i = 0; solution + i < separator; i++)
+            if (solution[i] == ' ')
+                phase1++;
+    sym = canonicalKey(cubiecube, &key);
+    conjugateMoves(sym, moves, n);
+
+    std::lock_guard<std::mutex> guard(store->appendLock);
+    map = store->map.load();
+    if (4 * (map->header->count.load() + 1) > 3 * map->header->capacity) {
+        if (growStore(store) != 0)
+            return -1;
+        map = store->map.load();
+    }
+    if ((slot = findSlot(map, &key)) == NULL)
+        return -1;
+    if (slot->tag.load(std::memory_order_relaxed) != 0)
+        return 0;
+    slot->edges = key.edges;
+    slot->length = (uint8_t) n;
+    slot->phase1 = (int8_t) phase1;
+    slot->maxDepth = (uint8_t) maxDepth;
+    slot->flags = 0;
+    slot->micros = micros;
+    memcpy(slot->moves, moves, n);
+    slot->tag.store(key.corners | SLOT_USED, std::memory_order_release);
+    map->header->count.fetch_add(1, std::memory_order_release);
+    return 1;
+}
+
+long storedSolutionCount(solutionstore_t* store)
+{
+    if (store == NULL)
+        return 0;
+    return (long) store->map.load(std::memory_order_acquire)->header->count.load(std::memory_order_acquire);
+}
+
+char* solutionStored(solutionstore_t* store, char* facelets, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir)
+{
+    return solutionStoredMs(store, facelets, maxDepth, timeOut < LONG_MAX / 1000 ? timeOut * 1000 : LONG_MAX,
+            useSeparator, cache_dir);
+}
+
+char* solutionStoredMs(solutionstore_t* store, char* facelets, int maxDepth, long timeOutMs, int useSeparator,
+        const char* cache_dir)
+{
+    cubiecube_t cc;
+    solvestatus_t status;
+    char* res;
+    if ((status = parseFacelets(facelets, &cc)) != SOLVE_OK) {
+        setSolveStatus(status);
+        return NULL;
+    }
+    if (store == NULL)
+        return solutionCubieMs(&cc, maxDepth, timeOutMs, useSeparator, cache_dir, NULL);
+    if ((res = lookupStoredSolution(store, &cc, maxDepth, useSeparator, NULL)) != NULL) {
+        setSolveStatus(SOLVE_OK);
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        res = solutionCubieMs(&cc, maxDepth, timeOutMs, 1, cache_dir, NULL);
+        if (res != NULL) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            appendStoredSolution(store, &cc, res, maxDepth, (unsigned) micros.count());
+            if (!useSeparator) {
+                // the separator was only requested for the metadata
+                char* dot = strstr(res, ". ");
+                if (dot != NULL)
+                    memmove(dot, dot + 2, strlen(dot + 2) + 1);
+            }
+        }
+    }
+    return res;
+}
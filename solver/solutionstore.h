@@ -0,0 +1,64 @@
+#ifndef SOLUTIONSTORE_H
+#define SOLUTIONSTORE_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// Persistent store of solutions in a memory mapped file, so cubes solved by one process are looked up by the next.
+// The file is an open addressing hash table of 64 byte slots behind a 64 byte header. A slot holds the canonical
+// key of a cube (see symmetry.h) and the solution of the canonical cube as move codes with its metadata, lookups
+// conjugate it back, so symmetric copies of a cube share one slot.
+//
+// Slots are only ever appended, never changed or removed. The writer fills a slot and publishes it by storing its
+// tag word last, so readers never see a half written slot and need no locks. Any number of processes and threads
+// may read a store at once, only one process may open it for writing (enforced with flock). When the table gets
+// 3/4 full the writer rehashes it into a file of twice the size and renames that over the old one; readers in other
+// processes keep seeing the old file until they reopen it.
+//
+// A stored solution is returned for every maxDepth it fits into, not only for the maxDepth it was searched with.
+// Not available on Windows, openSolutionStore returns NULL there.
+
+#define STORE_MAX_MOVES 40
+#define STORE_DEFAULT_CAPACITY (1 << 16)    // slots of a new store file
+
+// Metadata of a stored solution
+typedef struct {
+    int length;             // number of moves
+    int phase1;             // moves of phase1, -1 if the solution has no phase separator
+    int maxDepth;           // maxDepth of the search which found the solution
+    unsigned micros;        // time of that search
+} storemeta_t;
+
+typedef struct solutionstore solutionstore_t;
+
+// Open a store file, creating it with STORE_DEFAULT_CAPACITY slots if writable is set and it does not exist.
+// Returns NULL if the file is not a store, cannot be mapped or another process has it open for writing.
+solutionstore_t* openSolutionStore(const char* path, int writable);
+
+// Flush the appended slots to the file and unmap it
+void closeSolutionStore(solutionstore_t* store);
+
+// Stored solution of the cube as a solution string like solution() returns it (to be freed by the caller), NULL
+// if the cube is not stored or its solution is longer than maxDepth. meta may be NULL.
+char* lookupStoredSolution(solutionstore_t* store, cubiecube_t* cubiecube, int maxDepth, int useSeparator,
+        storemeta_t* meta);
+
+// Append the solution string of the cube found with maxDepth in micros microseconds.
+// Returns 1 if it was appended, 0 if the cube is stored already and -1 if the store is read only, the solution is
+// malformed or longer than STORE_MAX_MOVES, or the file could not be grown.
+int appendStoredSolution(solutionstore_t* store, cubiecube_t* cubiecube, const char* solution, int maxDepth,
+        unsigned micros);
+
+// Number of stored solutions
+long storedSolutionCount(solutionstore_t* store);
+
+// solution() with the store in front: the stored solution if there is one, else the search result, which is
+// appended if the store is writable. store may be NULL. Sets solveStatus() like solution().
+char* solutionStored(solutionstore_t* store, char* facelets, int maxDepth, long timeOut, int useSeparator,
+        const char* cache_dir);
+
+// Same as solutionStored with the computing time in milliseconds, like solutionCubieMs (search.h)
+char* solutionStoredMs(solutionstore_t* store, char* facelets, int maxDepth, long timeOutMs, int useSeparator,
+        const char* cache_dir);
+
+#endif
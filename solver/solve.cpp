@@ -3,15 +3,19 @@
 #include <stdlib.h>
 #include "search.h"
 #include "solve.h"
+#include "facecube.h"
+#include "optimize.h"
 #include <string>
 #include <vector>
 #pragma warning(disable:4996)
 
+#define MAX_SOLUTION_LENGTH 24  // maxDepth of the GUI solves, also the limit of an incremental re-solve
+
 std::string solver(char* cube) {
     char* facelets = cube;
     char* sol = solution(
         facelets,
-        24,
+        MAX_SOLUTION_LENGTH,
         1000,
         0,
         "cache"
@@ -24,23 +28,26 @@ std::string solver(char* cube) {
     return answer;
 }
 
-std::vector<std::string> get_solution(std::string Cube) {
-    char* cube = new char[(int)Cube.size()];
-    for (int i = 0; i < (int)Cube.size(); ++i) {
-        cube[i] = Cube[i];
+std::vector<uint8_t> get_solution(const std::string& Cube) {
+    std::vector<uint8_t> moves;
+    char* sol = solution((char*)Cube.c_str(), MAX_SOLUTION_LENGTH, 1000, 0, "cache");
+    if (sol != NULL) {// already run through optimizeMoves by solution()
+        parseMoves(sol, moves);
+        free(sol);
     }
-    std::string solution = solver(cube);
-    std::vector<std::string> the_solution;
-    std::string temp = "";
-    for (int i = 0; i < (int)solution.size(); ++i) {
-        if (solution[i] == ' ') {
-            the_solution.push_back(temp);
-            temp = "";
-        }
-        else {
-            temp.push_back(solution[i]);
-        }
+    return moves;
+}
+
+std::vector<uint8_t> get_solution(cubiecube_t* cube, lastsolve_t* last) {
+    std::vector<uint8_t> moves;
+    int fullSearch = !incrementalSolve(last, cube, INCREMENTAL_MAX_DELTA, MAX_SOLUTION_LENGTH, moves);
+    if (fullSearch) {
+        char facelets[55];
+        cubieToString(cube, facelets);
+        moves = get_solution(std::string(facelets));
+        if (!solvesCube(cube, moves.data(), (int)moves.size()))// invalid cube or no solution found
+            return moves;
     }
-    if((int)temp.size())the_solution.push_back(temp);
-    return the_solution;
+    recordLastSolve(last, cube, moves, fullSearch);
+    return moves;
 }
@@ -6,9 +6,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "search.h"
+#include "notation.h"
+#include "incremental.h"
 #include <string>
 #include<vector>
 std::string solver(char* cube);
-std::vector<std::string> get_solution(std::string Cube);
+// Solution of a cube definition string as move codes, empty if there is none
+std::vector<uint8_t> get_solution(const std::string& Cube);
+// Same for a cube on the cubie level, re-solved from the last solve (see incremental.h) if it is only a few moves
+// away from it. The solution is recorded in last.
+std::vector<uint8_t> get_solution(cubiecube_t* cube, lastsolve_t* last);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <atomic>
+#include "successors.h"
+#include "coordcube.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SUCCESSORS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(SEARCH_NO_PREFETCH)
+#define PREFETCH(addr) ((void) 0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && defined(SUCCESSORS_X86)
+#define PREFETCH(addr) _mm_prefetch((const char*) (addr), _MM_HINT_T0)
+#else
+#define PREFETCH(addr) ((void) 0)
+#endif
+
+typedef void (*successors_fn)(short, short, short, short*, short*, short*, signed char*);
+
+static void phase1SuccessorsScalar(short flip, short twist, short slice,
+        short* flipNext, short* twistNext, short* sliceNext, signed char* distNext)
+{
+    int mv;
+    short* flipRow = flipMove[flip];
+    short* twistRow = twistMove[twist];
+    short* sliceRow = FRtoBR_Move[slice * 24];
+    for (mv = 0; mv < N_MOVE; mv++) {
+        flipNext[mv] = flipRow[mv];
+        twistNext[mv] = twistRow[mv];
+        sliceNext[mv] = sliceRow[mv] / 24;
+        PREFETCH(&Slice_Flip_Prun[(N_SLICE1 * flipNext[mv] + sliceNext[mv]) / 2]);
+        PREFETCH(&Slice_Twist_Prun[(N_SLICE1 * twistNext[mv] + sliceNext[mv]) / 2]);
+    }
+    // the loads were issued above, now collect them
+    for (mv = 0; mv < N_MOVE; mv++) {
+        signed char d1 = getPruning(Slice_Flip_Prun, N_SLICE1 * flipNext[mv] + sliceNext[mv]);
+        signed char d2 = getPruning(Slice_Twist_Prun, N_SLICE1 * twistNext[mv] + sliceNext[mv]);
+        distNext[mv] = d1 > d2 ? d1 : d2;
+    }
+}
+
+#if defined(SUCCESSORS_X86)
+
+static int cpuHasAVX2(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)// OSXSAVE and AVX
+        return 0;
+    if ((_xgetbv(0) & 6) != 6)// the OS saves the ymm registers
+        return 0;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Pruning values of 8 nibble indices. The 4-byte aligned word holding the nibble is gathered, the nibble sits at
+// bit 4 * (index & 7) of it. Lanes whose word would cross the end of the table are left to getPruning.
+TARGET_AVX2 static __m256i gatherPruning(signed char* table, int size, __m256i idx)
+{
+    __m256i offset = _mm256_andnot_si256(_mm256_set1_epi32(3), _mm256_srli_epi32(idx, 1));
+    __m256i shift = _mm256_slli_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(7)), 2);
+    __m256i inside = _mm256_cmpgt_epi32(_mm256_set1_epi32(size - 3), offset);
+    __m256i word = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*) table, offset, inside, 1);
+    __m256i res = _mm256_and_si256(_mm256_srlv_epi32(word, shift), _mm256_set1_epi32(0x0f));
+    if (_mm256_movemask_epi8(inside) != -1) {
+        int lanes[8], values[8], i;
+        _mm256_storeu_si256((__m256i*) lanes, idx);
+        _mm256_storeu_si256((__m256i*) values, res);
+        for (i = 0; i < 8; i++)
+            if (((lanes[i] / 2) & ~3) + 3 >= size)
+                values[i] = getPruning(table, lanes[i]);
+        res = _mm256_loadu_si256((const __m256i*) values);
+    }
+    return res;
+}
+
+TARGET_AVX2 static void storeShorts(short* dst, __m256i v)
+{
+    __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storeu_si128((__m128i*) dst, packed);
+}
+
+TARGET_AVX2 static void phase1SuccessorsAVX2(short flip, short twist, short slice,
+        short* flipNext, short* twistNext, short* sliceNext, signed char* distNext)
+{
+    int base, mv;
+    short* flipRow = flipMove[flip];
+    short* twistRow = twistMove[twist];
+    short* sliceRow = FRtoBR_Move[slice * 24];
+    const __m256i nSlice1 = _mm256_set1_epi32(N_SLICE1);
+    // x / 24 == (x * 43691) >> 20 for all x < N_FRtoBR
+    const __m256i div24 = _mm256_set1_epi32(43691);
+
+    for (base = 0; base < 16; base += 8) {
+        __m256i f = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) (flipRow + base)));
+        __m256i t = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) (twistRow + base)));
+        __m256i s = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) (sliceRow + base)));
+        __m256i d1, d2, d;
+        __m128i d16;
+        s = _mm256_srli_epi32(_mm256_mullo_epi32(s, div24), 20);
+        d1 = gatherPruning(Slice_Flip_Prun, (int) sizeof(Slice_Flip_Prun),
+                _mm256_add_epi32(_mm256_mullo_epi32(f, nSlice1), s));
+        d2 = gatherPruning(Slice_Twist_Prun, (int) sizeof(Slice_Twist_Prun),
+                _mm256_add_epi32(_mm256_mullo_epi32(t, nSlice1), s));
+        d = _mm256_max_epi32(d1, d2);
+        storeShorts(flipNext + base, f);
+        storeShorts(twistNext + base, t);
+        storeShorts(sliceNext + base, s);
+        d16 = _mm_packs_epi32(_mm256_castsi256_si128(d), _mm256_extracti128_si256(d, 1));
+        _mm_storel_epi64((__m128i*) (distNext + base), _mm_packs_epi16(d16, d16));
+    }
+    // the rows have 18 entries, the last two moves are done without vector loads past the row
+    for (mv = 16; mv < N_MOVE; mv++) {
+        signed char d1, d2;
+        flipNext[mv] = flipRow[mv];
+        twistNext[mv] = twistRow[mv];
+        sliceNext[mv] = sliceRow[mv] / 24;
+        d1 = getPruning(Slice_Flip_Prun, N_SLICE1 * flipNext[mv] + sliceNext[mv]);
+        d2 = getPruning(Slice_Twist_Prun, N_SLICE1 * twistNext[mv] + sliceNext[mv]);
+        distNext[mv] = d1 > d2 ? d1 : d2;
+    }
+}
+
+#endif
+
+static successors_fn bestKernel(void)
+{
+#if defined(SUCCESSORS_X86)
+    if (cpuHasAVX2())
+        return phase1SuccessorsAVX2;
+#endif
+    return phase1SuccessorsScalar;
+}
+
+// Atomic because selectPhase1Kernel may run while other threads search, every node loads it once
+static std::atomic<successors_fn> kernel(bestKernel());
+
+int selectPhase1Kernel(int allowSimd)
+{
+    successors_fn selected = allowSimd ? bestKernel() : phase1SuccessorsScalar;
+    kernel.store(selected, std::memory_order_relaxed);
+    return selected != phase1SuccessorsScalar;
+}
+
+void phase1Successors(short flip, short twist, short slice,
+        short* flipNext, short* twistNext, short* sliceNext, signed char* distNext)
+{
+    kernel.load(std::memory_order_relaxed)(flip, twist, slice, flipNext, twistNext, sliceNext, distNext);
+}
@@ -0,0 +1,17 @@
+#ifndef SUCCESSORS_H
+#define SUCCESSORS_H
+
+// Evaluation of all 18 successors of a phase1 node at once. For each move mv, the successor coordinates are
+// written to flipNext[mv], twistNext[mv] and sliceNext[mv] (slice < 495, i.e. FRtoBR / 24), and the phase1
+// pruning value max(Slice_Flip_Prun, Slice_Twist_Prun) to distNext[mv].
+// An AVX2 kernel is used if the CPU supports it, otherwise a scalar loop. The choice is made at runtime, so the
+// same binary runs on every x86 CPU.
+void phase1Successors(short flip, short twist, short slice,
+        short* flipNext, short* twistNext, short* sliceNext, signed char* distNext);
+
+// Select the kernel used by phase1Successors. With allowSimd = 0 the scalar loop is always used, otherwise the
+// AVX2 kernel is used if available. Returns 1 if the AVX2 kernel is active afterwards. Both kernels give the same
+// results, so switching while other threads search is safe, they pick up the new kernel at their next node.
+int selectPhase1Kernel(int allowSimd);
+
+#endif
@@ -0,0 +1,166 @@
+#include "symmetry.h"
+#include "coordcube.h"
+#include "sequence.h"
+
+typedef struct {
+    cubiecube_t cube[N_SYM];
+    cubiecube_t inverse[N_SYM];     // inverse[s] = cube[inverseIdx[s]]
+    int inverseIdx[N_SYM];
+    uint8_t move[N_SYM][N_MOVE];
+} symtables_t;
+
+// 120 degree clockwise rotation around the long diagonal URF-DBL
+static const corner_t cpURF3[8] = { URF, DFR, DLF, UFL, UBR, DRB, DBL, ULB };
+static const signed char coURF3[8] = { 1, 2, 1, 2, 2, 1, 2, 1 };
+static const edge_t epURF3[12] = { UF, FR, DF, FL, UB, BR, DB, BL, UR, DR, DL, UL };
+static const signed char eoURF3[12] = { 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1 };
+// 180 degree rotation around the axis through the F and B centers
+static const corner_t cpF2[8] = { DLF, DFR, DRB, DBL, UFL, URF, UBR, ULB };
+static const signed char coF2[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static const edge_t epF2[12] = { DL, DF, DR, DB, UL, UF, UR, UB, FL, FR, BR, BL };
+static const signed char eoF2[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+// 90 degree clockwise rotation around the axis through the U and D centers
+static const corner_t cpU4[8] = { UBR, URF, UFL, ULB, DRB, DFR, DLF, DBL };
+static const signed char coU4[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static const edge_t epU4[12] = { UB, UR, UF, UL, DB, DR, DF, DL, BR, FR, FL, BL };
+static const signed char eoU4[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1 };
+// reflection at the plane through the U, D, F and B centers
+static const corner_t cpLR2[8] = { UFL, URF, UBR, ULB, DLF, DFR, DRB, DBL };
+static const signed char coLR2[8] = { 3, 3, 3, 3, 3, 3, 3, 3 };
+static const edge_t epLR2[12] = { UL, UF, UR, UB, DL, DF, DR, DB, FL, FR, BR, BL };
+static const signed char eoLR2[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+static void setCube(cubiecube_t* cubiecube, const corner_t* cp, const signed char* co, const edge_t* ep,
+        const signed char* eo)
+{
+    memcpy(cubiecube->cp, cp, sizeof(cubiecube->cp));
+    memcpy(cubiecube->co, co, sizeof(cubiecube->co));
+    memcpy(cubiecube->ep, ep, sizeof(cubiecube->ep));
+    memcpy(cubiecube->eo, eo, sizeof(cubiecube->eo));
+}
+
+static int sameCube(cubiecube_t* a, cubiecube_t* b)
+{
+    return memcmp(a->cp, b->cp, sizeof(a->cp)) == 0 && memcmp(a->co, b->co, sizeof(a->co)) == 0
+            && memcmp(a->ep, b->ep, sizeof(a->ep)) == 0 && memcmp(a->eo, b->eo, sizeof(a->eo)) == 0;
+}
+
+static void buildTables(symtables_t* t)
+{
+    cubiecube_t urf3, f2, u4, lr2, c, id, moves[N_MOVE];
+    int s, i, mv;
+
+    setCube(&urf3, cpURF3, coURF3, epURF3, eoURF3);
+    setCube(&f2, cpF2, coF2, epF2, eoF2);
+    setCube(&u4, cpU4, coU4, epU4, eoU4);
+    setCube(&lr2, cpLR2, coLR2, epLR2, eoLR2);
+    compileSequence(NULL, 0, &id);
+
+    c = id;
+    for (s = 0; s < N_SYM; s++) {
+        t->cube[s] = c;
+        multiply(&c, &lr2);
+        if (s % 2 == 1)
+            multiply(&c, &u4);
+        if (s % 8 == 7)
+            multiply(&c, &f2);
+        if (s % 16 == 15)
+            multiply(&c, &urf3);
+    }
+    // inverses by search, invCubieCube does not invert the orientations of mirrored cubes
+    for (s = 0; s < N_SYM; s++)
+        for (i = 0; i < N_SYM; i++) {
+            c = t->cube[s];
+            multiply(&c, &t->cube[i]);
+            if (sameCube(&c, &id)) {
+                t->inverseIdx[s] = i;
+                t->inverse[s] = t->cube[i];
+                break;
+            }
+        }
+
+    for (mv = 0; mv < N_MOVE; mv++)
+        moves[mv] = moveCubies()[mv];
+    for (s = 0; s < N_SYM; s++)
+        for (mv = 0; mv < N_MOVE; mv++) {
+            c = t->inverse[s];
+            multiply(&c, &moves[mv]);
+            multiply(&c, &t->cube[s]);
+            for (i = 0; i < N_MOVE; i++)
+                if (sameCube(&c, &moves[i]))
+                    t->move[s][mv] = (uint8_t) i;
+        }
+}
+
+static const symtables_t* tables(void)
+{
+    static const symtables_t* t = [] {
+        symtables_t* built = new symtables_t();
+        buildTables(built);
+        return built;
+    }();
+    return t;
+}
+
+cubiecube_t* symmetryCube(int s)
+{
+    return const_cast<cubiecube_t*>(&tables()->cube[s]);
+}
+
+int inverseSymmetry(int s)
+{
+    return tables()->inverseIdx[s];
+}
+
+void conjugateSymmetry(cubiecube_t* cubiecube, int s, cubiecube_t* result)
+{
+    const symtables_t* t = tables();
+    *result = t->inverse[s];
+    multiply(result, cubiecube);
+    multiply(result, const_cast<cubiecube_t*>(&t->cube[s]));
+}
+
+int symmetryMove(int s, int mv)
+{
+    return tables()->move[s][mv];
+}
+
+void conjugateMoves(int s, uint8_t* moves, int n)
+{
+    const symtables_t* t = tables();
+    int i;
+    for (i = 0; i < n; i++)
+        moves[i] = t->move[s][moves[i]];
+}
+
+int canonicalKey(cubiecube_t* cubiecube, cubiekey_t* key)
+{
+    const symtables_t* t = tables();
+    cubiecube_t c;
+    uint64_t corners;
+    int s, i, best = 0;
+
+    getCubieKey(cubiecube, key);
+    for (s = 1; s < N_SYM; s++) {
+        // the edges are only conjugated if the corners are not larger than the best key already
+        c = t->inverse[s];
+        cornerMultiply(&c, cubiecube);
+        cornerMultiply(&c, const_cast<cubiecube_t*>(&t->cube[s]));
+        corners = 0;
+        for (i = CORNER_COUNT - 1; i >= 0; i--)
+            corners = (corners << 5) | (uint64_t) (c.cp[i] << 2 | c.co[i]);
+        if (corners > key->corners)
+            continue;
+        edgeMultiply(&c, cubiecube);
+        edgeMultiply(&c, const_cast<cubiecube_t*>(&t->cube[s]));
+        if (corners == key->corners) {
+            cubiekey_t candidate;
+            getCubieKey(&c, &candidate);
+            if (candidate.edges >= key->edges)
+                continue;
+        }
+        getCubieKey(&c, key);
+        best = s;
+    }
+    return best;
+}
@@ -0,0 +1,36 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <stdint.h>
+#include "cubiecube.h"
+
+// The 48 symmetries of the cube (24 rotations, each with and without the reflection at the LR plane) as cubie
+// cubes. Symmetry s is S_URF3^(s/16) * S_F2^(s/8%2) * S_U4^(s/2%4) * S_LR2^(s%2) like in Kociemba's Java
+// implementation, mirrored corners have orientations 3..5 (see cornerMultiply). Symmetry 0 is the identity.
+//
+// A cube C and its conjugates S^-1 * C * S are the same position looked at from another side (or in a mirror),
+// they need the same number of moves. The canonical representative of C is the conjugate with the smallest
+// cubiekey_t, so all 48 symmetric copies of a cube share one canonical key. A maneuver M of the canonical cube
+// becomes S * M * S^-1 for C, move by move through symmetryMove.
+
+#define N_SYM 48
+
+// Symmetry cube s (the tables are built on the first call, which is thread-safe)
+cubiecube_t* symmetryCube(int s);
+
+// Index of the inverse symmetry
+int inverseSymmetry(int s);
+
+// result = S_s^-1 * cubiecube * S_s
+void conjugateSymmetry(cubiecube_t* cubiecube, int s, cubiecube_t* result);
+
+// Move code of S_s^-1 * mv * S_s. Reflections turn clockwise moves into counterclockwise ones.
+int symmetryMove(int s, int mv);
+
+// Replace every move of the maneuver by its conjugate under symmetry s
+void conjugateMoves(int s, uint8_t* moves, int n);
+
+// Canonical key of the cube. Returns the symmetry s with conjugateSymmetry(cubiecube, s) == canonical cube.
+int canonicalKey(cubiecube_t* cubiecube, cubiekey_t* key);
+
+#endif
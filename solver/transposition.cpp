@@ -0,0 +1,75 @@
+#include <stdint.h>
+#include <atomic>
+#include <new>
+#include "transposition.h"
+#include "coordcube.h"
+
+#define TT_BUCKET 4
+
+static std::atomic<uint64_t>* table = NULL;
+static uint64_t bucketMask = 0;
+static int minLeftUsed = 99;
+
+// Unique key of a subtree, 0 marks an empty entry
+static inline uint64_t ttKey(int flip, int twist, int slice, int left, int lastAxis)
+{
+    return ((((uint64_t) flip * N_TWIST + twist) * N_SLICE1 + slice) * 32 + left) * 8 + lastAxis + 1;
+}
+
+static inline std::atomic<uint64_t>* ttBucket(uint64_t key)
+{
+    return &table[((key * 0x9E3779B97F4A7C15ULL) >> 32 & bucketMask) * TT_BUCKET];
+}
+
+int initTransposition(long long bytes, int minLeft)
+{
+    uint64_t buckets = 1;
+    delete[] table;
+    table = NULL;
+    bucketMask = 0;
+    minLeftUsed = 99;
+    if (bytes < (long long) (TT_BUCKET * sizeof(uint64_t)))
+        return 0;
+    while (2 * buckets * TT_BUCKET * sizeof(uint64_t) <= (uint64_t) bytes)
+        buckets *= 2;
+    table = new (std::nothrow) std::atomic<uint64_t>[buckets * TT_BUCKET];
+    if (table == NULL)
+        return -1;
+    for (uint64_t i = 0; i < buckets * TT_BUCKET; i++)
+        table[i].store(0, std::memory_order_relaxed);
+    bucketMask = buckets - 1;
+    minLeftUsed = minLeft > 1 ? minLeft : 1;
+    return 0;
+}
+
+int transpositionMinLeft(void)
+{
+    return minLeftUsed;
+}
+
+int probeTransposition(int flip, int twist, int slice, int left, int lastAxis)
+{
+    uint64_t key = ttKey(flip, twist, slice, left, lastAxis);
+    std::atomic<uint64_t>* bucket = ttBucket(key);
+    int i;
+    for (i = 0; i < TT_BUCKET; i++)
+        if (bucket[i].load(std::memory_order_relaxed) == key)
+            return 1;
+    return 0;
+}
+
+void storeTransposition(int flip, int twist, int slice, int left, int lastAxis)
+{
+    uint64_t key = ttKey(flip, twist, slice, left, lastAxis);
+    std::atomic<uint64_t>* bucket = ttBucket(key);
+    int i;
+    for (i = 0; i < TT_BUCKET; i++) {
+        uint64_t entry = bucket[i].load(std::memory_order_relaxed);
+        if (entry == key)
+            return;
+        if (entry == 0 && bucket[i].compare_exchange_strong(entry, key, std::memory_order_relaxed))
+            return;
+    }
+    // bucket full, replace an entry. Losing an entry only costs a search of that subtree.
+    bucket[key % TT_BUCKET].store(key, std::memory_order_relaxed);
+}
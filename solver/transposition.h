@@ -0,0 +1,31 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+// Transposition table for the phase1 search.
+// An entry records that the phase1 subtree below the coordinates (flip, twist, slice), with 'left' moves to go and
+// the last move on axis 'lastAxis' (6 if there is no last move), does not contain a single position of the H
+// subgroup at its last level. This only depends on the phase1 move graph, so an entry stays valid for all later
+// IDA* iterations, all cubes and all threads, and such subtrees are skipped when they are visited again.
+//
+// The table is bounded and lock-free: every entry is one 64 bit word which is read and written atomically, a full
+// bucket overwrites one of its entries.
+//
+// The table is disabled by default. The move ordering of the search already avoids most transpositions, on random
+// cubes only about 2% of the lookups hit and the extra memory accesses cost more than the skipped subtrees save.
+
+// Allocate a table of at most 'bytes' bytes. 0 disables the table. Only subtrees with at least minLeft moves to go
+// are looked up and stored, smaller ones are cheaper to search than to look up.
+// Must not be called while a search is running. Returns 0 on success and -1 if the memory could not be allocated
+// (the table is disabled then).
+int initTransposition(long long bytes, int minLeft);
+
+// Minimal number of moves to go for which the table is used, larger than any search depth if it is disabled
+int transpositionMinLeft(void);
+
+// Returns 1 if the subtree is known to contain no position of the H subgroup at its last level
+int probeTransposition(int flip, int twist, int slice, int left, int lastAxis);
+
+// Record that the subtree contains no position of the H subgroup at its last level
+void storeTransposition(int flip, int twist, int slice, int left, int lastAxis);
+
+#endif
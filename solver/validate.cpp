@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include "validate.h"
+#include "facecube.h"
+
+const char* solveStatusMessage(solvestatus_t status)
+{
+    static const char* messages[SOLVE_STATUS_COUNT] = { "no error", "there is not exactly one facelet of each colour",
+            "not all 12 edges exist exactly once", "one edge has to be flipped", "not all corners exist exactly once",
+            "one corner has to be twisted", "two corners or two edges have to be exchanged",
+            "no solution exists for the given maxDepth", "no solution within the given time",
+            "a parameter of the solve is out of range" };
+    return status >= SOLVE_OK && status <= SOLVE_INVALID_ARGUMENT ? messages[status] : "unknown error";
+}
+
+solvestatus_t validate(const char* facelets)
+{
+    cubiecube_t cc;
+    return parseFacelets(facelets, &cc);
+}
+
+solvestatus_t parseFacelets(const char* facelets, cubiecube_t* result)
+{
+    facecube_t fc;
+    cubiecube_t* cc;
+    int count[6] = {0};
+    int i;
+
+    for (i = 0; i < 54 && facelets[i] != '\0'; i++)
+        switch(facelets[i]) {
+            case 'U':
+                fc.f[i] = U;
+                break;
+            case 'R':
+                fc.f[i] = R;
+                break;
+            case 'F':
+                fc.f[i] = F;
+                break;
+            case 'D':
+                fc.f[i] = D;
+                break;
+            case 'L':
+                fc.f[i] = L;
+                break;
+            case 'B':
+                fc.f[i] = B;
+                break;
+            default:
+                return SOLVE_FACELET_COUNT;
+        }
+    if (i < 54)
+        return SOLVE_FACELET_COUNT;
+    for (i = 0; i < 54; i++)
+        count[fc.f[i]]++;
+    for (i = 0; i < 6; i++)
+        if (count[i] != 9)
+            return SOLVE_FACELET_COUNT;
+
+    cc = toCubieCube(&fc);
+    *result = *cc;
+    free(cc);
+    return validateCubie(result);
+}
+
+solvestatus_t validateCubie(cubiecube_t* cubiecube)
+{
+    return (solvestatus_t) -verify(cubiecube);
+}
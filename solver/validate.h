@@ -0,0 +1,35 @@
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include "cubiecube.h"
+
+// Status of a solve, numbered like the error codes documented for solution() in search.h
+typedef enum {
+    SOLVE_OK = 0,
+    SOLVE_FACELET_COUNT = 1,    // there is not exactly one facelet of each colour
+    SOLVE_EDGE_MISSING = 2,     // not all 12 edges exist exactly once
+    SOLVE_EDGE_FLIP = 3,        // one edge has to be flipped
+    SOLVE_CORNER_MISSING = 4,   // not all corners exist exactly once
+    SOLVE_CORNER_TWIST = 5,     // one corner has to be twisted
+    SOLVE_PARITY = 6,           // two corners or two edges have to be exchanged
+    SOLVE_MAX_DEPTH = 7,        // no solution exists for the given maxDepth
+    SOLVE_TIMEOUT = 8,          // no solution within the given time
+    SOLVE_INVALID_ARGUMENT = 9  // a parameter of the solve is out of range, e.g. a move cost below 1
+} solvestatus_t;
+
+#define SOLVE_STATUS_COUNT 10   // number of statuses, for tables indexed by them
+
+const char* solveStatusMessage(solvestatus_t status);
+
+// Checks of a cube definition string which solution() does before the search: the colour count and verify().
+// Neither touches the pruning tables, so a server can reject bad input before it queues it. A string shorter than
+// 54 characters gives SOLVE_FACELET_COUNT.
+solvestatus_t validate(const char* facelets);
+
+// Same, and the cube on the cubie level in result. result is filled whenever the colour count is right.
+solvestatus_t parseFacelets(const char* facelets, cubiecube_t* result);
+
+// Status of verify() for a cube on the cubie level
+solvestatus_t validateCubie(cubiecube_t* cubiecube);
+
+#endif
@@ -0,0 +1,267 @@
+#include <time.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include "weighted.h"
+#include "search.h"
+#include "facecube.h"
+#include "notation.h"
+
+#define MAX_LENGTH 30       // longest maneuver searched, both phases together, the most solutionToString takes
+#define MAX_PHASE2 10       // longest phase2 maneuver, like in totalDepth
+#define NO_BOUND 0x7fffffff
+
+static const int phase2Moves[10] = { 0, 1, 2, 4, 7, 9, 10, 11, 13, 16 };
+
+typedef struct {
+    const movecost_t* cost;
+    int minCost1;           // cheapest move, scales the phase1 pruning values
+    int minCost2;           // cheapest phase2 move, scales the phase2 pruning values
+    coordcube_t* root;
+    unsigned char path[MAX_LENGTH + 1];
+    unsigned char best[MAX_LENGTH + 1];
+    int bestLength;
+    int bestPhase1;         // phase1 length of the best solution
+    int bestCost;           // cost of the best solution, maxCost + 1 while there is none
+    int prevBound1;         // phase1 nodes with a cost up to this bound were tried in phase2 already
+    int bound1, next1;
+    int bound2, next2;
+    long nodes;
+    std::chrono::steady_clock::time_point deadline;
+    int timedOut;
+} weighted_t;
+
+void initMoveCost(movecost_t* cost)
+{
+    int mv;
+    for (mv = 0; mv < N_MOVE; mv++)
+        cost->cost[mv] = 1;
+}
+
+int parseMoveCost(const char* text, movecost_t* cost)
+{
+    movecost_t parsed = *cost;
+    const char* p = text;
+    while (*p != '\0') {
+        const char* start;
+        char* end;
+        long value;
+        int mv;
+        while (*p == ' ' || *p == '\t' || *p == ',')
+            p++;
+        if (*p == '\0')
+            break;
+        start = p;
+        while (*p != '\0' && *p != '=')
+            p++;
+        if (*p != '=' || (mv = parseMove(std::string_view(start, p - start))) < 0)
+            return -1;
+        value = strtol(p + 1, &end, 10);
+        if (end == p + 1 || value < 1 || value > 1000000)
+            return -1;
+        parsed.cost[mv] = (int) value;
+        p = end;
+    }
+    *cost = parsed;
+    return 0;
+}
+
+int maneuverCost(const movecost_t* cost, const unsigned char* moves, int n)
+{
+    int i, sum = 0;
+    for (i = 0; i < n; i++)
+        sum += cost->cost[moves[i]];
+    return sum;
+}
+
+// moves on the axis of the last move and moves on the opposite axis in the order D U, L R, B F are never searched
+static inline int redundant(int lastAxis, int ax)
+{
+    return lastAxis == ax || lastAxis - 3 == ax;
+}
+
+static inline int isPhase2Move(int mv)
+{
+    int ax = mv / 3;
+    return ax == 0 || ax == 3 || mv % 3 == 1;
+}
+
+static int searchPhase2(weighted_t* w, int URFtoDLF, int FRtoBR, int parity, int URtoDF, int cost, int n, int left)
+{
+    int i;
+    int d1 = getPruning(Slice_URFtoDLF_Parity_Prun, (N_SLICE2 * URFtoDLF + FRtoBR) * 2 + parity);
+    int d2 = getPruning(Slice_URtoDF_Parity_Prun, (N_SLICE2 * URtoDF + FRtoBR) * 2 + parity);
+    int f = cost + (d1 > d2 ? d1 : d2) * w->minCost2;
+    if ((++w->nodes & 4095) == 0 && std::chrono::steady_clock::now() > w->deadline)
+        w->timedOut = 1;
+    if (w->timedOut || d1 > left || d2 > left)
+        return 0;
+    if (f > w->bound2) {
+        if (f < w->next2)
+            w->next2 = f;
+        return 0;
+    }
+    if (d1 == 0 && d2 == 0) {// solved
+        w->bestLength = n;
+        w->bestCost = cost;
+        return 1;
+    }
+    for (i = 0; i < 10; i++) {
+        int mv = phase2Moves[i];
+        if (n != 0 && redundant(w->path[n - 1] / 3, mv / 3))
+            continue;
+        w->path[n] = (unsigned char) mv;
+        if (searchPhase2(w, URFtoDLF_Move[URFtoDLF][mv], FRtoBR_Move[FRtoBR][mv], parityMove[parity][mv],
+                URtoDF_Move[URtoDF][mv], cost + w->cost->cost[mv], n + 1, left - 1))
+            return 1;
+    }
+    return 0;
+}
+
+// Search the cheapest phase2 maneuver for the phase1 maneuver path[0..n), which has reached the H subgroup, that
+// results in a solution cheaper than the best one.
+static void solvePhase2(weighted_t* w, int cost, int n)
+{
+    int URFtoDLF = w->root->URFtoDLF, FRtoBR = w->root->FRtoBR, parity = w->root->parity;
+    int URtoUL = w->root->URtoUL, UBtoDF = w->root->UBtoDF;
+    int i, URtoDF;
+    int d1, d2;
+    for (i = 0; i < n; i++) {
+        int mv = w->path[i];
+        URFtoDLF = URFtoDLF_Move[URFtoDLF][mv];
+        FRtoBR = FRtoBR_Move[FRtoBR][mv];
+        parity = parityMove[parity][mv];
+        URtoUL = URtoUL_Move[URtoUL][mv];
+        UBtoDF = UBtoDF_Move[UBtoDF][mv];
+    }
+    URtoDF = MergeURtoULandUBtoDF[URtoUL][UBtoDF];
+    d1 = getPruning(Slice_URFtoDLF_Parity_Prun, (N_SLICE2 * URFtoDLF + FRtoBR) * 2 + parity);
+    d2 = getPruning(Slice_URtoDF_Parity_Prun, (N_SLICE2 * URtoDF + FRtoBR) * 2 + parity);
+    w->bound2 = cost + (d1 > d2 ? d1 : d2) * w->minCost2;
+    while (w->bound2 < w->bestCost && !w->timedOut) {
+        w->next2 = NO_BOUND;
+        if (searchPhase2(w, URFtoDLF, FRtoBR, parity, URtoDF, cost, n, MAX_LENGTH - n < MAX_PHASE2 ? MAX_LENGTH - n : MAX_PHASE2)) {
+            for (i = 0; i < w->bestLength; i++)
+                w->best[i] = w->path[i];
+            w->bestPhase1 = n;
+            return;
+        }
+        w->bound2 = w->next2 > w->bound2 + w->minCost2 ? w->next2 : w->bound2 + w->minCost2;
+    }
+}
+
+static void searchPhase1(weighted_t* w, int flip, int twist, int slice, int cost, int n)
+{
+    int mv;
+    int d1 = getPruning(Slice_Flip_Prun, N_SLICE1 * flip + slice);
+    int d2 = getPruning(Slice_Twist_Prun, N_SLICE1 * twist + slice);
+    int f = cost + (d1 > d2 ? d1 : d2) * w->minCost1;
+
+    if ((++w->nodes & 4095) == 0 && std::chrono::steady_clock::now() > w->deadline)
+        w->timedOut = 1;
+    if (w->timedOut || f >= w->bestCost)
+        return;
+    if (f > w->bound1) {
+        if (f < w->next1)
+            w->next1 = f;
+        return;
+    }
+    // a phase1 maneuver ending with a phase2 move was tried without that move already
+    if (f == cost && cost > w->prevBound1 && (n == 0 || !isPhase2Move(w->path[n - 1])))
+        solvePhase2(w, cost, n);
+    if (n == MAX_LENGTH)
+        return;
+    for (mv = 0; mv < N_MOVE; mv++) {
+        if (n != 0 && redundant(w->path[n - 1] / 3, mv / 3))
+            continue;
+        w->path[n] = (unsigned char) mv;
+        searchPhase1(w, flipMove[flip][mv], twistMove[twist][mv], FRtoBR_Move[slice * 24][mv] / 24,
+                cost + w->cost->cost[mv], n + 1);
+    }
+}
+
+char* solutionWeighted(char* facelets, int maxCost, long timeOutMs, int useSeparator, const char* cache_dir,
+        const movecost_t* cost, int* resultCost)
+{
+    weighted_t* w;
+    cubiecube_t* cc;
+    search_t* search;
+    solvestatus_t status;
+    char* res = NULL;
+    int i, mv;
+
+    for (mv = 0; mv < N_MOVE; mv++)
+        if (cost->cost[mv] < 1) {
+            setSolveStatus(SOLVE_INVALID_ARGUMENT);
+            return NULL;
+        }
+    cc = (cubiecube_t*) malloc(sizeof(cubiecube_t));
+    if ((status = parseFacelets(facelets, cc)) != SOLVE_OK) {
+        setSolveStatus(status);
+        free(cc);
+        return NULL;
+    }
+    if (PRUNING_INITED == 0)
+        initPruning(cache_dir);
+
+    w = (weighted_t*) calloc(1, sizeof(weighted_t));
+    w->cost = cost;
+    w->minCost1 = w->minCost2 = NO_BOUND;
+    for (mv = 0; mv < N_MOVE; mv++)
+        w->minCost1 = cost->cost[mv] < w->minCost1 ? cost->cost[mv] : w->minCost1;
+    for (i = 0; i < 10; i++)
+        w->minCost2 = cost->cost[phase2Moves[i]] < w->minCost2 ? cost->cost[phase2Moves[i]] : w->minCost2;
+    w->root = get_coordcube(cc);
+    w->bestCost = maxCost + 1;
+    w->prevBound1 = -1;
+    w->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeOutMs);
+
+    // the move count optimized solution is the first upper bound, so there is a solution whenever it is found in time
+    if ((res = solutionCubieMs(cc, 24, timeOutMs, 1, cache_dir, NULL)) != NULL) {
+        const char* separator = strchr(res, '.');
+        int n = parseMoves(res, w->path, MAX_LENGTH);
+        if (n >= 0 && maneuverCost(cost, w->path, n) <= maxCost) {
+            for (i = 0; i < n; i++)
+                w->best[i] = w->path[i];
+            w->bestLength = n;
+            w->bestCost = maneuverCost(cost, w->path, n);
+            w->bestPhase1 = 0;
+            for (i = 0; separator != NULL && res + i < separator; i++)
+                if (res[i] == ' ')
+                    w->bestPhase1++;
+        }
+        free(res);
+        res = NULL;
+    }
+
+    // +++++++++++++++++++ IDA* on the phase1 cost +++++++++++++++++++++++++++++
+    w->bound1 = 0;
+    while (w->bound1 < w->bestCost && !w->timedOut) {
+        w->next1 = NO_BOUND;
+        searchPhase1(w, w->root->flip, w->root->twist, w->root->FRtoBR / 24, 0, 0);
+        w->prevBound1 = w->bound1;
+        if (w->next1 == NO_BOUND)
+            break;
+        // with very different costs the bound would grow in tiny steps. Larger steps keep the search complete,
+        // all phase1 maneuvers are tried in phase2 in the iteration whose bound range contains their cost.
+        w->bound1 = w->next1 > w->bound1 + w->minCost1 ? w->next1 : w->bound1 + w->minCost1;
+    }
+
+    if (w->bestCost <= maxCost) {
+        search = (search_t*) calloc(1, sizeof(search_t));
+        for (i = 0; i < w->bestLength; i++) {
+            search->ax[i] = w->best[i] / 3;
+            search->po[i] = w->best[i] % 3 + 1;
+        }
+        res = solutionToString(search, w->bestLength, useSeparator ? w->bestPhase1 : -1);
+        if (resultCost != NULL)
+            *resultCost = w->bestCost;
+        free(search);
+    }
+    setSolveStatus(res != NULL ? SOLVE_OK : w->timedOut ? SOLVE_TIMEOUT : SOLVE_MAX_DEPTH);
+    free(w->root);
+    free(w);
+    free(cc);
+    return res;
+}
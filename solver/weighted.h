@@ -0,0 +1,39 @@
+#ifndef WEIGHTED_H
+#define WEIGHTED_H
+
+#include "coordcube.h"
+
+// Two-phase search which minimizes the execution time of a maneuver instead of its number of moves.
+// Every move code (3 * axis + power - 1) has its own cost, e.g. the time in 10 ms steps a robot needs for it, so a
+// 180 degree turn can be slower than a 90 degree turn and faces which need a regrip can be more expensive.
+// Both phases are IDA* searches bounded by the accumulated cost. Their pruning values are move counts, multiplied
+// by the cheapest move of the phase they stay admissible.
+//
+// The search keeps the cheapest solution found so far and goes on with larger phase1 bounds. Once the phase1 bound
+// reaches the cost of that solution, no cheaper two-phase maneuver exists and the search stops, otherwise it stops
+// at the time limit with the best solution so far.
+
+typedef struct {
+    int cost[N_MOVE];   // cost of each move code, at least 1
+} movecost_t;
+
+// All moves cost 1, the half turn metric
+void initMoveCost(movecost_t* cost);
+
+// Set costs from a list like "U=10 U2=18 U'=10 R=14". Moves which are not listed keep their cost.
+// Returns 0 on success and -1 if the text is malformed or a cost is smaller than 1.
+int parseMoveCost(const char* text, movecost_t* cost);
+
+// Total cost of n move codes
+int maneuverCost(const movecost_t* cost, const unsigned char* moves, int n);
+
+// Computes the cheapest solution string for a given cube, in the format of solution().
+// maxCost is the maximal allowed cost of the maneuver, timeOutMs the computing time in milliseconds (unlike the
+// seconds of solution()) after which the best solution so far is returned. The move count optimized solution which
+// seeds the search runs within the same time. The cost of the returned solution is written to resultCost (if it is
+// not NULL). Returns NULL if the cube is invalid, a cost is below 1 (SOLVE_INVALID_ARGUMENT) or no solution within
+// maxCost was found in time, solveStatus() (search.h) tells which, with SOLVE_MAX_DEPTH for maxCost.
+char* solutionWeighted(char* facelets, int maxCost, long timeOutMs, int useSeparator, const char* cache_dir,
+        const movecost_t* cost, int* resultCost);
+
+#endif
@@ -0,0 +1,305 @@
+// rubik_solve - solve a file of cube definition strings, one per line, with all cores.
+//
+// usage: rubik_solve INPUT [options]
+//   --output FILE         write the solutions to FILE instead of stdout, appended to when resuming
+//   --threads N           solver threads, 0 for one per hardware thread (default 0)
+//   --window N            lines in flight between the reader and the writer (default 4096)
+//   --max-depth D         maxDepth passed to solution() (default 21)
+//   --timeout T           timeOut passed to solution() in seconds (default 10)
+//   --cache DIR           directory of the cached pruning tables (default cache)
+//   --solution-cache N    entries of the solution cache, for inputs with repeated cubes (default 0)
+//   --store FILE          persistent solution store (solutionstore.h), looked up before every search
+//   --resume OFFSET       start at byte OFFSET of the input, as printed by an interrupted run
+//   --progress S          print the throughput to stderr every S seconds, 0 never (default 5)
+//
+// The input is memory mapped and split into lines in place, a line is never copied to the heap. Every input line
+// gives exactly one output line in input order: the solution, or "Error N" with the error codes of solution().
+// Solver threads take the next line and solve it into one slot of a ring of --window slots, the writer prints the
+// slots in order. A thread which is --window lines ahead of the writer waits, so the memory does not depend on the
+// size of the input; input pages behind the writer are released from the page cache mapping as it goes.
+//
+// SIGINT stops taking new lines, the lines in flight are finished and written, and the byte offset to resume from
+// is printed. Resuming with it continues with the first line which was not written.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "solver/search.h"
+#include "solver/coordcube.h"
+#include "solver/facecube.h"
+#include "solver/nearsolved.h"
+#include "solver/solutioncache.h"
+#include "solver/solutionstore.h"
+
+#define RESULT_SIZE 128     // room for a solution of 30 moves and the newline
+
+typedef std::chrono::steady_clock clock_type;
+
+typedef struct {
+    long long seq;          // line number which the slot holds, -1 while it is free
+    size_t end;             // input offset behind the line, the resume point once it is written
+    int length;             // length of result
+    char result[RESULT_SIZE];
+} slot_t;
+
+static struct {
+    const char* input;      // mapped input
+    size_t size;
+    size_t cursor;          // offset of the next line to take
+    long long nextSeq;      // its line number
+    long long written;      // lines written, slots of later lines are in flight
+    int stop;
+} state;
+
+static std::mutex lock;
+static std::condition_variable slotFree, slotDone;
+static std::vector<slot_t> slots;
+static std::atomic<int> interrupted(0);
+
+static struct {
+    int maxDepth;
+    long timeOut;
+    const char* cacheDir;
+    solutionstore_t* store;
+} config = { 21, 10, "cache", NULL };
+
+static void onSignal(int sig)
+{
+    (void) sig;
+    interrupted = 1;
+}
+
+// Solve the line [begin, end) of the input into the slot
+static void solveLine(const char* begin, const char* end, slot_t* slot)
+{
+    char facelets[55];
+    char* res;
+    int error;
+    while (end > begin && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+        end--;
+    while (begin < end && (*begin == ' ' || *begin == '\t'))
+        begin++;
+    if (end - begin != 54) {
+        slot->length = snprintf(slot->result, RESULT_SIZE, "Error 1\n");
+        return;
+    }
+    memcpy(facelets, begin, 54);
+    facelets[54] = '\0';
+    // invalid cubes are rejected by solutionStored, which parses the cube only once
+    res = solutionStored(config.store, facelets, config.maxDepth, config.timeOut, 0, config.cacheDir);
+    if (res == NULL) {
+        error = solveStatus();
+        slot->length = snprintf(slot->result, RESULT_SIZE, "Error %d\n", error);
+        return;
+    }
+    int n = (int) strlen(res);
+    while (n > 0 && res[n - 1] == ' ')
+        n--;
+    n = std::min(n, RESULT_SIZE - 2);
+    memcpy(slot->result, res, n);
+    slot->result[n] = '\n';
+    slot->length = n + 1;
+    free(res);
+}
+
+static void worker(void)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        // the next line, once its slot was written
+        slotFree.wait(guard, [] {
+            return state.stop || state.cursor >= state.size || state.nextSeq < state.written + (long long) slots.size();
+        });
+        if (state.stop || state.cursor >= state.size)
+            return;
+        long long seq = state.nextSeq++;
+        const char* begin = state.input + state.cursor;
+        const char* newline = (const char*) memchr(begin, '\n', state.size - state.cursor);
+        const char* end = newline != NULL ? newline : state.input + state.size;
+        state.cursor = newline != NULL ? newline - state.input + 1 : state.size;
+        slot_t* slot = &slots[seq % slots.size()];
+        slot->end = state.cursor;
+        guard.unlock();
+
+        solveLine(begin, end, slot);
+
+        guard.lock();
+        slot->seq = seq;
+        slotDone.notify_all();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* inputPath = NULL;
+    const char* outputPath = NULL;
+    const char* storePath = NULL;
+    int threads = 0;
+    long window = 4096;
+    long long resume = 0;
+    long cacheEntries = 0;
+    double progressEvery = 5.0;
+    FILE* out = stdout;
+    struct stat st;
+    int fd;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (arg[0] != '-' && inputPath == NULL) {
+            inputPath = arg;
+            continue;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        if (!strcmp(arg, "--output"))
+            outputPath = value;
+        else if (!strcmp(arg, "--threads"))
+            threads = atoi(value);
+        else if (!strcmp(arg, "--window"))
+            window = std::max(1L, atol(value));
+        else if (!strcmp(arg, "--max-depth"))
+            config.maxDepth = atoi(value);
+        else if (!strcmp(arg, "--timeout"))
+            config.timeOut = atol(value);
+        else if (!strcmp(arg, "--cache"))
+            config.cacheDir = value;
+        else if (!strcmp(arg, "--solution-cache"))
+            cacheEntries = atol(value);
+        else if (!strcmp(arg, "--store"))
+            storePath = value;
+        else if (!strcmp(arg, "--resume"))
+            resume = atoll(value);
+        else if (!strcmp(arg, "--progress"))
+            progressEvery = atof(value);
+        else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+        i++;
+    }
+    if (inputPath == NULL) {
+        fprintf(stderr, "usage: rubik_solve INPUT [options]\n");
+        return 2;
+    }
+    if (threads <= 0)
+        threads = (int) std::max(1u, std::thread::hardware_concurrency());
+
+    if ((fd = open(inputPath, O_RDONLY)) < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "cannot open %s\n", inputPath);
+        return 1;
+    }
+    state.size = (size_t) st.st_size;
+    if (resume < 0 || (size_t) resume > state.size) {
+        fprintf(stderr, "resume offset %lld is outside of the input\n", resume);
+        return 2;
+    }
+    if (state.size > 0) {
+        void* map = mmap(NULL, state.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "cannot map %s\n", inputPath);
+            return 1;
+        }
+        madvise(map, state.size, MADV_SEQUENTIAL);
+        state.input = (const char*) map;
+    }
+    close(fd);
+    state.cursor = (size_t) resume;
+    if (outputPath != NULL && (out = fopen(outputPath, resume > 0 ? "ab" : "wb")) == NULL) {
+        fprintf(stderr, "cannot write %s\n", outputPath);
+        return 1;
+    }
+    static char outBuffer[1 << 16];
+    setvbuf(out, outBuffer, _IOFBF, sizeof(outBuffer));
+
+    // the pruning tables before the threads start, their lazy initialization is not thread-safe
+    initPruning(config.cacheDir);
+    ensureNearSolved();
+    initSolutionCache(cacheEntries);
+    if (storePath != NULL && (config.store = openSolutionStore(storePath, 1)) == NULL) {
+        fprintf(stderr, "cannot open the solution store %s\n", storePath);
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    slots.resize((size_t) window);
+    for (slot_t& slot : slots)
+        slot.seq = -1;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(worker);
+
+    auto start = clock_type::now();
+    auto lastReport = start;
+    long long lastWritten = 0;
+    size_t committed = state.cursor;    // input offset behind the last written line
+    size_t released = committed & ~(size_t) 0xfffff;
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        slot_t* slot = &slots[state.written % slots.size()];
+        slotDone.wait_for(guard, std::chrono::milliseconds(200), [slot] { return slot->seq == state.written; });
+        if (interrupted && !state.stop) {
+            state.stop = 1;
+            slotFree.notify_all();
+        }
+        if (slot->seq == state.written) {
+            slot_t done = *slot;
+            slot->seq = -1;
+            state.written++;
+            slotFree.notify_all();
+            guard.unlock();
+            fwrite(done.result, 1, (size_t) done.length, out);
+            committed = done.end;
+            // the pages behind the writer are not read again
+            if (committed - released >= (64u << 20)) {
+                size_t upto = committed & ~(size_t) 0xfffff;
+                madvise((void*) (state.input + released), upto - released, MADV_DONTNEED);
+                released = upto;
+            }
+            guard.lock();
+        } else if (state.written == state.nextSeq && (state.stop || state.cursor >= state.size)) {
+            break;  // every line taken is written
+        }
+        auto now = clock_type::now();
+        if (progressEvery > 0 && std::chrono::duration<double>(now - lastReport).count() >= progressEvery) {
+            double total = std::chrono::duration<double>(now - start).count();
+            double recent = std::chrono::duration<double>(now - lastReport).count();
+            fprintf(stderr, "%lld lines  %.1f lines/s (last %.0f s: %.1f lines/s)  offset %zu of %zu\n",
+                    state.written, state.written / total, recent, (state.written - lastWritten) / recent, committed,
+                    state.size);
+            lastReport = now;
+            lastWritten = state.written;
+        }
+    }
+    guard.unlock();
+    for (std::thread& t : workers)
+        t.join();
+    fflush(out);
+    if (out != stdout)
+        fclose(out);
+    closeSolutionStore(config.store);
+
+    double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    fprintf(stderr, "%lld lines in %.3f s: %.1f lines/s, %.2f MB/s\n", state.written, seconds,
+            seconds > 0 ? state.written / seconds : 0.0,
+            seconds > 0 ? (committed - (size_t) resume) / seconds / (1 << 20) : 0.0);
+    if (committed < state.size) {
+        fprintf(stderr, "interrupted, continue with --resume %zu\n", committed);
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,620 @@
+// rubik_solverd - long running solver service on a UNIX domain socket.
+//
+// usage: rubik_solverd [options]
+//        rubik_solverd --socket PATH --request JSON      send one JSON request and print the response
+//   --socket PATH         socket to listen on (default /tmp/rubik_solverd.sock)
+//   --threads N           solver threads, 0 for one per hardware thread (default 0)
+//   --queue N             requests waiting for a solver thread before new ones are refused (default 1024)
+//   --cache DIR           directory of the cached pruning tables (default cache)
+//   --max-depth D         maxDepth of requests which do not give one (default 21)
+//   --deadline MS         deadline of requests which do not give one (default 10000)
+//   --solution-cache N    entries of the solution cache (default 65536)
+//   --store FILE          persistent solution store (solutionstore.h), looked up before every search
+//
+// The pruning tables, the near solved table and the symmetry tables are set up once at start, every request after
+// that is only a search. A connection speaks one of two protocols, chosen by its first byte:
+//
+// JSON lines: one object per line, the response carries the id of the request. Responses of one connection may come
+// in any order, they are written when their solve is done.
+//   {"id":1,"op":"solve","cube":"UUUUUUUUURRR...","max_depth":21,"deadline_ms":500}   (0 or missing: defaults)
+//     -> {"id":1,"ok":true,"solution":"R2 U' F ...","length":19,"ms":3.41}
+//     -> {"id":1,"ok":false,"error":5,"message":"one corner has to be twisted"}
+//   {"id":2,"op":"health"}   -> {"id":2,"ok":true,"workers":4,"queued":0,"active":1,"uptime_s":12.5}
+//   {"id":3,"op":"stats"}    -> {"id":3,"ok":true,"requests":...,"solved":...,...}
+//
+// Binary: fixed 68 byte requests, little endian.
+//   request   u8 op (1 solve, 2 health, 3 stats), u8 maxDepth (0 default), u16 0, u32 id, u32 deadline ms
+//             (0 default), 54 bytes cube definition string (ignored unless op is 1), u8 0 x 2
+//   response  u32 id, u8 status, u8 0, u16 payload length, payload: the move codes of the solution for op 1, the
+//             JSON object of health or stats for op 2 and 3
+//
+// Error codes (JSON "error" and binary status): 1..9 like solveStatus() in search.h, 10 the request waited longer
+// than its deadline, 11 the queue was full, 12 the request was malformed. A search gets the rest of the deadline in
+// milliseconds and answers 8 if it does not find a solution within it.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "solver/search.h"
+#include "solver/coordcube.h"
+#include "solver/facecube.h"
+#include "solver/nearsolved.h"
+#include "solver/notation.h"
+#include "solver/solutioncache.h"
+#include "solver/solutionstore.h"
+#include "solver/symmetry.h"
+
+#define OP_SOLVE 1
+#define OP_HEALTH 2
+#define OP_STATS 3
+#define ERR_DEADLINE SOLVE_STATUS_COUNT    // the codes of the service follow the solve statuses
+#define ERR_OVERLOADED (SOLVE_STATUS_COUNT + 1)
+#define ERR_MALFORMED (SOLVE_STATUS_COUNT + 2)
+#define BINARY_REQUEST 68
+#define MAX_DEPTH 30        // longest max_depth, like MAX_SOLVE_DEPTH of rubik_solver.h
+
+typedef std::chrono::steady_clock clock_type;
+
+// Text of an error code, the solve statuses have theirs in validate.h
+static const char* errorMessage(int error)
+{
+    static const char* messages[3] = { "deadline passed in the queue", "queue full", "malformed request" };
+    if (error >= ERR_DEADLINE && error <= ERR_MALFORMED)
+        return messages[error - ERR_DEADLINE];
+    return solveStatusMessage((solvestatus_t) error);
+}
+
+// A client connection. Solver threads write responses to it, so writes are serialized. Queued jobs hold a reference,
+// the descriptor is closed when the last one is done.
+struct connection {
+    int fd;
+    int binary;
+    std::mutex writeLock;
+    ~connection()
+    {
+        close(fd);
+    }
+};
+typedef struct connection connection_t;
+
+typedef struct {
+    std::shared_ptr<connection_t> conn;
+    uint32_t id;
+    int op;
+    int maxDepth;
+    char cube[55];
+    clock_type::time_point received;
+    clock_type::time_point deadline;
+} job_t;
+
+static struct {
+    const char* cacheDir;
+    int defaultMaxDepth;
+    long defaultDeadline;
+    size_t queueLimit;
+    int workers;
+    solutionstore_t* store;
+    clock_type::time_point started;
+} config = { "cache", 21, 10000, 1024, 0, NULL, clock_type::now() };
+
+static std::mutex queueLock;
+static std::condition_variable queueReady;
+static std::deque<job_t> queue;
+static int workersStop = 0;     // set under queueLock, the workers return when the queue is empty
+static std::mutex connectionsLock;
+static std::set<int> connections;   // descriptors of the connections still read from
+
+static std::atomic<long long> requests(0), solved(0), deadlineMisses(0), overloaded(0), malformed(0);
+static std::atomic<long long> errors[SOLVE_STATUS_COUNT];   // requests answered with each solve status
+static std::atomic<long long> solveMicros(0);
+static std::atomic<int> active(0);
+static std::atomic<int> stopping(0);  // set by SIGINT and SIGTERM
+
+// Count a request answered with a solve status, other codes have counters of their own
+static void countError(int status)
+{
+    if (status > SOLVE_OK && status < SOLVE_STATUS_COUNT)
+        errors[status]++;
+}
+
+static void onSignal(int sig)
+{
+    (void) sig;
+    int saved = errno;
+    stopping = 1;
+    errno = saved;
+}
+
+static int writeAll(int fd, const char* data, size_t length)
+{
+    while (length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        data += n;
+        length -= (size_t) n;
+    }
+    return 0;
+}
+
+// +++++++++++++++++++++++++++++++ responses +++++++++++++++++++++++++++++++++++++
+
+static void respond(connection_t* conn, uint32_t id, int status, const std::string& json, const uint8_t* payload,
+        size_t length)
+{
+    std::lock_guard<std::mutex> guard(conn->writeLock);
+    if (conn->binary) {
+        std::string frame(8, '\0');
+        frame[0] = (char) (id & 0xff);
+        frame[1] = (char) (id >> 8 & 0xff);
+        frame[2] = (char) (id >> 16 & 0xff);
+        frame[3] = (char) (id >> 24 & 0xff);
+        frame[4] = (char) status;
+        frame[6] = (char) (length & 0xff);
+        frame[7] = (char) (length >> 8 & 0xff);
+        frame.append((const char*) payload, length);
+        writeAll(conn->fd, frame.data(), frame.size());
+    } else {
+        std::string line = json + "\n";
+        writeAll(conn->fd, line.data(), line.size());
+    }
+}
+
+static void respondError(connection_t* conn, uint32_t id, int error)
+{
+    char json[160];
+    snprintf(json, sizeof(json), "{\"id\":%u,\"ok\":false,\"error\":%d,\"message\":\"%s\"}", id, error,
+            errorMessage(error));
+    respond(conn, id, error, json, NULL, 0);
+}
+
+static std::string healthJson(void)
+{
+    char json[200];
+    size_t queued;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        queued = queue.size();
+    }
+    snprintf(json, sizeof(json), "\"workers\":%d,\"queued\":%zu,\"active\":%d,\"uptime_s\":%.1f", config.workers,
+            queued, active.load(), std::chrono::duration<double>(clock_type::now() - config.started).count());
+    return json;
+}
+
+static std::string statsJson(void)
+{
+    cachestats_t cache;
+    char json[600];
+    std::string counts;
+    long long solves = solved.load();
+    solutionCacheStats(&cache);
+    // the requests answered with the solve statuses 1, 2, ...
+    for (int status = SOLVE_OK + 1; status < SOLVE_STATUS_COUNT; status++)
+        counts += (counts.empty() ? "" : ",") + std::to_string(errors[status].load());
+    snprintf(json, sizeof(json), "\"requests\":%lld,\"solved\":%lld,\"avg_ms\":%.3f,\"errors\":[%s],"
+            "\"deadline_misses\":%lld,\"overloaded\":%lld,\"malformed\":%lld,"
+            "\"cache_hits\":%lld,\"cache_misses\":%lld,\"cache_entries\":%ld,\"stored\":%ld",
+            requests.load(), solves, solves == 0 ? 0.0 : solveMicros.load() / 1000.0 / solves, counts.c_str(),
+            deadlineMisses.load(), overloaded.load(), malformed.load(), cache.hits, cache.misses, cache.entries,
+            storedSolutionCount(config.store));
+    return json;
+}
+
+static void respondInfo(connection_t* conn, uint32_t id, const std::string& fields)
+{
+    std::string json = "{" + fields + "}";
+    respond(conn, id, 0, "{\"id\":" + std::to_string(id) + ",\"ok\":true," + fields + "}",
+            (const uint8_t*) json.data(), json.size());
+}
+
+// +++++++++++++++++++++++++++++++ solving +++++++++++++++++++++++++++++++++++++++
+
+static void solveJob(job_t& job)
+{
+    clock_type::time_point start = clock_type::now();
+    long left = (long) std::chrono::duration_cast<std::chrono::milliseconds>(job.deadline - start).count();
+    int error;
+    char* res = left > 0 ? solutionStoredMs(config.store, job.cube, job.maxDepth, left, 0, config.cacheDir) : NULL;
+    if (res == NULL) {
+        error = left > 0 ? solveStatus() : SOLVE_TIMEOUT;
+        countError(error);
+        respondError(job.conn.get(), job.id, error);
+        return;
+    }
+    double ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    uint8_t moves[64];
+    int n = parseMoves(res, moves, 64);
+    std::string text(res);
+    free(res);
+    while (!text.empty() && text.back() == ' ')
+        text.pop_back();
+    solved++;
+    solveMicros += (long long) (ms * 1000.0);
+    char json[400];
+    snprintf(json, sizeof(json), "{\"id\":%u,\"ok\":true,\"solution\":\"%s\",\"length\":%d,\"ms\":%.3f}", job.id,
+            text.c_str(), n, ms);
+    respond(job.conn.get(), job.id, 0, json, moves, n < 0 ? 0 : (size_t) n);
+}
+
+static void worker(void)
+{
+    for (;;) {
+        job_t job;
+        {
+            std::unique_lock<std::mutex> lock(queueLock);
+            queueReady.wait(lock, [] { return !queue.empty() || workersStop; });
+            if (queue.empty())
+                return;
+            job = queue.front();
+            queue.pop_front();
+            active++;
+        }
+        if (clock_type::now() >= job.deadline) {
+            deadlineMisses++;
+            respondError(job.conn.get(), job.id, ERR_DEADLINE);
+        } else {
+            solveJob(job);
+        }
+        job.conn.reset();
+        active--;
+    }
+}
+
+// Health and stats are answered by the connection thread, solves of valid cubes go to the queue
+static void dispatch(job_t& job)
+{
+    requests++;
+    if (job.op == OP_HEALTH) {
+        respondInfo(job.conn.get(), job.id, healthJson());
+        return;
+    }
+    if (job.op == OP_STATS) {
+        respondInfo(job.conn.get(), job.id, statsJson());
+        return;
+    }
+    if (job.op != OP_SOLVE) {
+        malformed++;
+        respondError(job.conn.get(), job.id, ERR_MALFORMED);
+        return;
+    }
+    // invalid cubes are answered right away, they would only take a place in the queue
+    int error = validate(job.cube);
+    if (error != SOLVE_OK) {
+        countError(error);
+        respondError(job.conn.get(), job.id, error);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        if (queue.size() < config.queueLimit && !stopping) {
+            queue.push_back(job);
+            queueReady.notify_one();
+            return;
+        }
+    }
+    overloaded++;
+    respondError(job.conn.get(), job.id, ERR_OVERLOADED);
+}
+
+// +++++++++++++++++++++++++++++++ protocols +++++++++++++++++++++++++++++++++++++
+
+// Fields of a flat JSON object with string, number and literal values. Returns 0 if the line is not such an object.
+static int parseFlatJson(const std::string& line, std::map<std::string, std::string>& fields)
+{
+    size_t i = 0, n = line.size();
+    auto skip = [&] { while (i < n && strchr(" \t\r", line[i]) != NULL) i++; };
+    auto string = [&](std::string& out) {
+        if (i >= n || line[i] != '"')
+            return 0;
+        for (i++; i < n && line[i] != '"'; i++) {
+            if (line[i] == '\\' && i + 1 < n)
+                i++;
+            out.push_back(line[i]);
+        }
+        return i++ < n ? 1 : 0;
+    };
+    skip();
+    if (i >= n || line[i++] != '{')
+        return 0;
+    skip();
+    if (i < n && line[i] == '}')
+        return 1;
+    for (;;) {
+        std::string key, value;
+        skip();
+        if (!string(key))
+            return 0;
+        skip();
+        if (i >= n || line[i++] != ':')
+            return 0;
+        skip();
+        if (i < n && line[i] == '"') {
+            if (!string(value))
+                return 0;
+        } else {
+            while (i < n && strchr(",} \t\r", line[i]) == NULL)
+                value.push_back(line[i++]);
+            if (value.empty())
+                return 0;
+        }
+        fields[key] = value;
+        skip();
+        if (i < n && line[i] == ',') {
+            i++;
+            continue;
+        }
+        return i < n && line[i] == '}';
+    }
+}
+
+static void jsonRequest(std::shared_ptr<connection_t>& conn, const std::string& line)
+{
+    std::map<std::string, std::string> fields;
+    job_t job;
+    job.conn = conn;
+    job.received = clock_type::now();
+    job.id = 0;
+    if (!parseFlatJson(line, fields)) {
+        requests++;
+        malformed++;
+        respondError(conn.get(), 0, ERR_MALFORMED);
+        return;
+    }
+    job.id = (uint32_t) strtoul(fields["id"].c_str(), NULL, 10);
+    const std::string& op = fields["op"];
+    job.op = op == "solve" ? OP_SOLVE : op == "health" ? OP_HEALTH : op == "stats" ? OP_STATS : 0;
+    int maxDepth = fields.count("max_depth") ? atoi(fields["max_depth"].c_str()) : 0;
+    job.maxDepth = maxDepth == 0 ? config.defaultMaxDepth : maxDepth;
+    long deadline = fields.count("deadline_ms") ? atol(fields["deadline_ms"].c_str()) : 0;
+    job.deadline = job.received + std::chrono::milliseconds(deadline <= 0 ? config.defaultDeadline : deadline);
+    const std::string& cube = fields["cube"];
+    if (job.op == OP_SOLVE && (cube.size() != 54 || job.maxDepth < 1 || job.maxDepth > MAX_DEPTH)) {
+        requests++;
+        malformed++;
+        respondError(conn.get(), job.id, ERR_MALFORMED);
+        return;
+    }
+    memcpy(job.cube, cube.c_str(), std::min(cube.size(), (size_t) 54) + 1);
+    dispatch(job);
+}
+
+static void binaryRequest(std::shared_ptr<connection_t>& conn, const uint8_t* frame)
+{
+    job_t job;
+    job.conn = conn;
+    job.received = clock_type::now();
+    job.op = frame[0];
+    job.maxDepth = frame[1] == 0 ? config.defaultMaxDepth : frame[1];
+    job.id = frame[4] | frame[5] << 8 | frame[6] << 16 | (uint32_t) frame[7] << 24;
+    uint32_t deadline = frame[8] | frame[9] << 8 | frame[10] << 16 | (uint32_t) frame[11] << 24;
+    job.deadline = job.received + std::chrono::milliseconds(deadline == 0 ? config.defaultDeadline : (long) deadline);
+    memcpy(job.cube, frame + 12, 54);
+    job.cube[54] = '\0';
+    if (job.op == OP_SOLVE && job.maxDepth > MAX_DEPTH) {
+        requests++;
+        malformed++;
+        respondError(conn.get(), job.id, ERR_MALFORMED);
+        return;
+    }
+    dispatch(job);
+}
+
+static void serveConnection(int fd)
+{
+    std::shared_ptr<connection_t> conn = std::make_shared<connection_t>();
+    std::string pending;
+    char buffer[65536];
+    int decided = 0;
+    conn->fd = fd;
+    conn->binary = 0;
+    {
+        std::lock_guard<std::mutex> guard(connectionsLock);
+        connections.insert(fd);
+    }
+    for (;;) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        pending.append(buffer, (size_t) n);
+        if (!decided) {
+            size_t first = pending.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos)
+                continue;
+            conn->binary = pending[first] >= OP_SOLVE && pending[first] <= OP_STATS;
+            decided = 1;
+        }
+        size_t used = 0;
+        if (conn->binary) {
+            for (; pending.size() - used >= BINARY_REQUEST; used += BINARY_REQUEST)
+                binaryRequest(conn, (const uint8_t*) pending.data() + used);
+        } else {
+            size_t end;
+            while ((end = pending.find('\n', used)) != std::string::npos) {
+                std::string line = pending.substr(used, end - used);
+                used = end + 1;
+                if (line.find_first_not_of(" \t\r") != std::string::npos)
+                    jsonRequest(conn, line);
+            }
+        }
+        pending.erase(0, used);
+    }
+    shutdown(fd, SHUT_RD);
+    std::lock_guard<std::mutex> guard(connectionsLock);
+    connections.erase(fd);
+}
+
+// +++++++++++++++++++++++++++++++ client mode +++++++++++++++++++++++++++++++++++
+
+static int connectSocket(const char* path)
+{
+    struct sockaddr_un addr;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int sendRequest(const char* path, const char* request)
+{
+    std::string line = std::string(request) + "\n", response;
+    char c;
+    int fd = connectSocket(path);
+    if (fd < 0) {
+        fprintf(stderr, "cannot connect to %s\n", path);
+        return 1;
+    }
+    writeAll(fd, line.data(), line.size());
+    while (recv(fd, &c, 1, 0) == 1 && c != '\n')
+        response.push_back(c);
+    close(fd);
+    printf("%s\n", response.c_str());
+    return response.empty();
+}
+
+int main(int argc, char** argv)
+{
+    const char* socketPath = "/tmp/rubik_solverd.sock";
+    const char* storePath = NULL;
+    const char* request = NULL;
+    long cacheEntries = 65536;
+    struct sockaddr_un addr;
+    int listenFd;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        if (!strcmp(arg, "--socket"))
+            socketPath = value;
+        else if (!strcmp(arg, "--threads"))
+            config.workers = atoi(value);
+        else if (!strcmp(arg, "--queue"))
+            config.queueLimit = (size_t) std::max(1, atoi(value));
+        else if (!strcmp(arg, "--cache"))
+            config.cacheDir = value;
+        else if (!strcmp(arg, "--max-depth")) {
+            config.defaultMaxDepth = atoi(value);
+            if (config.defaultMaxDepth < 1 || config.defaultMaxDepth > MAX_DEPTH) {
+                fprintf(stderr, "--max-depth must be 1..%d\n", MAX_DEPTH);
+                return 2;
+            }
+        }
+        else if (!strcmp(arg, "--deadline"))
+            config.defaultDeadline = atol(value);
+        else if (!strcmp(arg, "--solution-cache"))
+            cacheEntries = atol(value);
+        else if (!strcmp(arg, "--store"))
+            storePath = value;
+        else if (!strcmp(arg, "--request"))
+            request = value;
+        else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+        i++;
+    }
+    if (request != NULL)
+        return sendRequest(socketPath, request);
+
+    if (strlen(socketPath) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "socket path %s is too long\n", socketPath);
+        return 2;
+    }
+    if (config.workers <= 0)
+        config.workers = std::max(1u, std::thread::hardware_concurrency());
+
+    // all tables before the first request, so no request pays for them; the lazy initialization of the pruning
+    // tables is not thread-safe either
+    auto initStart = clock_type::now();
+    initPruning(config.cacheDir);
+    ensureNearSolved();
+    symmetryCube(0);
+    initSolutionCache(cacheEntries);
+    if (storePath != NULL && (config.store = openSolutionStore(storePath, 1)) == NULL) {
+        fprintf(stderr, "cannot open the solution store %s\n", storePath);
+        return 2;
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socketPath);
+    unlink(socketPath);
+    if (listenFd < 0 || bind(listenFd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listenFd, 64) != 0) {
+        fprintf(stderr, "cannot listen on %s: %s\n", socketPath, strerror(errno));
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < config.workers; i++)
+        workers.emplace_back(worker);
+    config.started = clock_type::now();
+    printf("rubik_solverd: %s  %d workers  init %.3f s\n", socketPath, config.workers,
+            std::chrono::duration<double>(config.started - initStart).count());
+    fflush(stdout);
+
+    while (!stopping) {
+        struct pollfd pfd = { listenFd, POLLIN, 0 };
+        if (poll(&pfd, 1, 200) <= 0)
+            continue;
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd >= 0)
+            std::thread(serveConnection, fd).detach();
+    }
+    close(listenFd);
+    unlink(socketPath);
+    // new solves are refused now. The connections stop reading, the workers finish the accepted solves and the
+    // store is closed after them.
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> guard(connectionsLock);
+            if (connections.empty())
+                break;
+            for (int fd : connections)
+                shutdown(fd, SHUT_RD);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        workersStop = 1;
+    }
+    queueReady.notify_all();
+    for (std::thread& t : workers)
+        t.join();
+    closeSolutionStore(config.store);
+    printf("rubik_solverd: %lld requests, %lld solved\n", requests.load(), solved.load());
+    return 0;
+}